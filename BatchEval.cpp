@@ -0,0 +1,206 @@
+#include "BatchEval.hpp"
+#include "BitOps.hpp"
+
+#if defined(__x86_64__) && defined(__GNUC__)   // SSE2 が必ずある x86-64 だけ（i386 では SSE2 は前提にできない）
+#define TETRIS_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+static_assert(Board::WIDTH + 2 <= 16, "row transitions use two extra wall bits in a 16-bit lane");
+
+namespace {
+
+    const unsigned FULL = Board::FULL_ROW;
+    const unsigned PAIR_MASK = Board::FULL_ROW >> 1;                 // 列 x と x+1 の組
+    const unsigned LEFT_WALL = 1u;                                   // x = 0 の左隣は壁
+    const unsigned RIGHT_WALL = 1u << (Board::WIDTH - 1);            // x = WIDTH-1 の右隣は壁
+    const unsigned WALLED_ROW = 1u | (1u << (Board::WIDTH + 1));     // 壁を両端に足した行
+    const unsigned WALLED_PAIRS = (1u << (Board::WIDTH + 1)) - 1;    // 壁つきの行で隣り合う組
+
+    void resizeFeatures(BatchFeatures& out, int n) {
+        out.aggregateHeight.resize(n);
+        out.holes.resize(n);
+        out.bumpiness.resize(n);
+        out.wells.resize(n);
+        out.rowTransitions.resize(n);
+        out.columnTransitions.resize(n);
+    }
+
+    // ==== スカラー版（1盤面ずつ） ====
+    // 上の行から順に「その列より上にブロックがあるか」のビット列 covered を作りながら数える
+    BoardFeatures scalarFeatures(const Board::Row* rows, int stride, int i) {
+        BoardFeatures f;
+        unsigned covered = 0, prev = rows[i];   // 一番上の行より上（天井）は数えない
+        for (int y = 0; y < Board::HEIGHT; ++y) {
+            unsigned r = rows[y * stride + i];
+            f.holes += bitCount(covered & ~r);
+            covered |= r;
+            f.aggregateHeight += bitCount(covered);
+            f.bumpiness += bitCount((covered ^ (covered >> 1)) & PAIR_MASK);
+            f.wells += bitCount(~covered & ((r << 1) | LEFT_WALL) & ((r >> 1) | RIGHT_WALL) & FULL);
+            unsigned walled = (r << 1) | WALLED_ROW;
+            if (covered) f.rowTransitions += bitCount((walled ^ (walled >> 1)) & WALLED_PAIRS);
+            f.columnTransitions += bitCount(prev ^ r);
+            prev = r;
+        }
+        f.columnTransitions += bitCount(~prev & FULL);   // 一番下の行と床
+        return f;
+    }
+
+    void kernelScalar(const Board::Row* rows, int stride, BatchFeatures& out) {
+        for (int i = 0; i < stride; ++i) {
+            BoardFeatures f = scalarFeatures(rows, stride, i);
+            out.aggregateHeight[i] = static_cast<std::int16_t>(f.aggregateHeight);
+            out.holes[i] = static_cast<std::int16_t>(f.holes);
+            out.bumpiness[i] = static_cast<std::int16_t>(f.bumpiness);
+            out.wells[i] = static_cast<std::int16_t>(f.wells);
+            out.rowTransitions[i] = static_cast<std::int16_t>(f.rowTransitions);
+            out.columnTransitions[i] = static_cast<std::int16_t>(f.columnTransitions);
+        }
+    }
+
+#ifdef TETRIS_BATCH_X86
+    // ==== SSE2 版（8盤面ずつ、x86-64 なら必ず使える） ====
+    // 16bit ごとのビット数（SWAR）
+    inline __m128i popcount16(__m128i x) {
+        x = _mm_sub_epi16(x, _mm_and_si128(_mm_srli_epi16(x, 1), _mm_set1_epi16(0x5555)));
+        x = _mm_add_epi16(_mm_and_si128(x, _mm_set1_epi16(0x3333)),
+            _mm_and_si128(_mm_srli_epi16(x, 2), _mm_set1_epi16(0x3333)));
+        x = _mm_and_si128(_mm_add_epi16(x, _mm_srli_epi16(x, 4)), _mm_set1_epi16(0x0F0F));
+        return _mm_and_si128(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), _mm_set1_epi16(0x1F));
+    }
+
+    void kernelSse2(const Board::Row* rows, int stride, BatchFeatures& out) {
+        const __m128i full = _mm_set1_epi16(static_cast<short>(FULL));
+        const __m128i pairMask = _mm_set1_epi16(static_cast<short>(PAIR_MASK));
+        const __m128i leftWall = _mm_set1_epi16(static_cast<short>(LEFT_WALL));
+        const __m128i rightWall = _mm_set1_epi16(static_cast<short>(RIGHT_WALL));
+        const __m128i walledRow = _mm_set1_epi16(static_cast<short>(WALLED_ROW));
+        const __m128i walledPairs = _mm_set1_epi16(static_cast<short>(WALLED_PAIRS));
+        const __m128i zero = _mm_setzero_si128();
+
+        for (int i = 0; i < stride; i += 8) {
+            __m128i covered = zero;
+            __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows + i));
+            __m128i height = zero, holes = zero, bump = zero, wells = zero, rowT = zero, colT = zero;
+            for (int y = 0; y < Board::HEIGHT; ++y) {
+                __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows + y * stride + i));
+                holes = _mm_add_epi16(holes, popcount16(_mm_andnot_si128(r, covered)));
+                covered = _mm_or_si128(covered, r);
+                height = _mm_add_epi16(height, popcount16(covered));
+                bump = _mm_add_epi16(bump, popcount16(_mm_and_si128(
+                    _mm_xor_si128(covered, _mm_srli_epi16(covered, 1)), pairMask)));
+                __m128i sides = _mm_and_si128(_mm_or_si128(_mm_slli_epi16(r, 1), leftWall),
+                    _mm_or_si128(_mm_srli_epi16(r, 1), rightWall));
+                wells = _mm_add_epi16(wells, popcount16(_mm_andnot_si128(covered, _mm_and_si128(sides, full))));
+                __m128i walled = _mm_or_si128(_mm_slli_epi16(r, 1), walledRow);
+                __m128i rt = popcount16(_mm_and_si128(_mm_xor_si128(walled, _mm_srli_epi16(walled, 1)), walledPairs));
+                rowT = _mm_add_epi16(rowT, _mm_andnot_si128(_mm_cmpeq_epi16(covered, zero), rt));
+                colT = _mm_add_epi16(colT, popcount16(_mm_xor_si128(prev, r)));
+                prev = r;
+            }
+            colT = _mm_add_epi16(colT, popcount16(_mm_andnot_si128(prev, full)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&out.aggregateHeight[i]), height);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&out.holes[i]), holes);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&out.bumpiness[i]), bump);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&out.wells[i]), wells);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&out.rowTransitions[i]), rowT);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&out.columnTransitions[i]), colT);
+        }
+    }
+
+    // ==== AVX2 版（16盤面ずつ、対応 CPU のときだけ使う） ====
+    __attribute__((target("avx2"))) inline __m256i popcount16Avx2(__m256i x) {
+        x = _mm256_sub_epi16(x, _mm256_and_si256(_mm256_srli_epi16(x, 1), _mm256_set1_epi16(0x5555)));
+        x = _mm256_add_epi16(_mm256_and_si256(x, _mm256_set1_epi16(0x3333)),
+            _mm256_and_si256(_mm256_srli_epi16(x, 2), _mm256_set1_epi16(0x3333)));
+        x = _mm256_and_si256(_mm256_add_epi16(x, _mm256_srli_epi16(x, 4)), _mm256_set1_epi16(0x0F0F));
+        return _mm256_and_si256(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), _mm256_set1_epi16(0x1F));
+    }
+
+    __attribute__((target("avx2"))) void kernelAvx2(const Board::Row* rows, int stride, BatchFeatures& out) {
+        const __m256i full = _mm256_set1_epi16(static_cast<short>(FULL));
+        const __m256i pairMask = _mm256_set1_epi16(static_cast<short>(PAIR_MASK));
+        const __m256i leftWall = _mm256_set1_epi16(static_cast<short>(LEFT_WALL));
+        const __m256i rightWall = _mm256_set1_epi16(static_cast<short>(RIGHT_WALL));
+        const __m256i walledRow = _mm256_set1_epi16(static_cast<short>(WALLED_ROW));
+        const __m256i walledPairs = _mm256_set1_epi16(static_cast<short>(WALLED_PAIRS));
+        const __m256i zero = _mm256_setzero_si256();
+
+        for (int i = 0; i < stride; i += 16) {
+            __m256i covered = zero;
+            __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows + i));
+            __m256i height = zero, holes = zero, bump = zero, wells = zero, rowT = zero, colT = zero;
+            for (int y = 0; y < Board::HEIGHT; ++y) {
+                __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rows + y * stride + i));
+                holes = _mm256_add_epi16(holes, popcount16Avx2(_mm256_andnot_si256(r, covered)));
+                covered = _mm256_or_si256(covered, r);
+                height = _mm256_add_epi16(height, popcount16Avx2(covered));
+                bump = _mm256_add_epi16(bump, popcount16Avx2(_mm256_and_si256(
+                    _mm256_xor_si256(covered, _mm256_srli_epi16(covered, 1)), pairMask)));
+                __m256i sides = _mm256_and_si256(_mm256_or_si256(_mm256_slli_epi16(r, 1), leftWall),
+                    _mm256_or_si256(_mm256_srli_epi16(r, 1), rightWall));
+                wells = _mm256_add_epi16(wells, popcount16Avx2(_mm256_andnot_si256(covered, _mm256_and_si256(sides, full))));
+                __m256i walled = _mm256_or_si256(_mm256_slli_epi16(r, 1), walledRow);
+                __m256i rt = popcount16Avx2(_mm256_and_si256(_mm256_xor_si256(walled, _mm256_srli_epi16(walled, 1)), walledPairs));
+                rowT = _mm256_add_epi16(rowT, _mm256_andnot_si256(_mm256_cmpeq_epi16(covered, zero), rt));
+                colT = _mm256_add_epi16(colT, popcount16Avx2(_mm256_xor_si256(prev, r)));
+                prev = r;
+            }
+            colT = _mm256_add_epi16(colT, popcount16Avx2(_mm256_andnot_si256(prev, full)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out.aggregateHeight[i]), height);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out.holes[i]), holes);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out.bumpiness[i]), bump);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out.wells[i]), wells);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out.rowTransitions[i]), rowT);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out.columnTransitions[i]), colT);
+        }
+    }
+#endif
+
+    enum class Kernel { Scalar, Sse2, Avx2 };
+
+    // 最初の1回だけ CPU を調べる
+    Kernel selectKernel() {
+#ifdef TETRIS_BATCH_X86
+        static const Kernel kernel = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") ? Kernel::Avx2 : Kernel::Sse2;
+        }();
+        return kernel;
+#else
+        return Kernel::Scalar;
+#endif
+    }
+
+}
+
+// ==================== BoardBatch クラス ====================
+void BoardBatch::reset(int boards) {
+    count = boards;
+    stride = (boards + LANES - 1) / LANES * LANES;
+    rows.assign(static_cast<std::size_t>(stride) * Board::HEIGHT, 0);
+}
+
+void evaluateBatch(const BoardBatch& batch, BatchFeatures& out) {
+    resizeFeatures(out, batch.stride);
+    switch (selectKernel()) {
+#ifdef TETRIS_BATCH_X86
+    case Kernel::Avx2: kernelAvx2(batch.rows.data(), batch.stride, out); break;
+    case Kernel::Sse2: kernelSse2(batch.rows.data(), batch.stride, out); break;
+#endif
+    default: kernelScalar(batch.rows.data(), batch.stride, out); break;
+    }
+}
+
+BoardFeatures computeBoardFeatures(const BitBoard& board) {
+    return scalarFeatures(board.rows.data(), 1, 0);
+}
+
+const char* batchKernelName() {
+    switch (selectKernel()) {
+    case Kernel::Avx2: return "avx2";
+    case Kernel::Sse2: return "sse2";
+    default:           return "scalar";
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include "Board.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// まとめて評価する盤面の集まり（Structure of Arrays）について
+// 盤面ごとに行を並べるのではなく「y 行目を全盤面ぶん」並べ、rows[y * stride + i] を盤面 i の y 行目とする
+// こうすると同じ行を 8 個（SSE2）/ 16 個（AVX2）の盤面について1命令で処理でき、
+// MoveGenerator が1回で出した候補をすべて同時に評価できる
+// stride は LANES の倍数に切り上げ、余りは空の盤面として計算する（結果は捨てる）
+//
+// 求める特徴量（盤面ごと）:
+//   aggregateHeight   各列の高さの合計
+//   holes             上に同じ列のブロックがある空きマスの数
+//   bumpiness         隣り合う列の高さの差の合計
+//   wells             井戸のマスの数（上が開いていて、左右が壁かブロックの空きマス。深さ d の井戸は d マス）
+//   rowTransitions    積まれている範囲の各行で、左から右へ埋まり・空きが入れ替わる回数（左右の壁は埋まりとみなす）
+//   columnTransitions 各列で、上から下へ埋まり・空きが入れ替わる回数（床は埋まりとみなし、天井は数えない）
+//
+// カーネルは実行時に CPU を調べて AVX2 → SSE2 → スカラーの順に選ぶ（x86-64 以外と MSVC はスカラーのみ）
+
+class BoardBatch {
+public:
+    static const int LANES = 16;              // stride の単位（AVX2 の 16bit × 16）
+
+    std::vector<Board::Row> rows;             // rows[y * stride + i]
+    int count = 0;                            // 盤面の数
+    int stride = 0;                           // 1行ぶんの要素数（count を LANES の倍数に切り上げたもの）
+
+    // 盤面の数を決め、すべて空にする（確保済みの領域は使い回す）
+    void reset(int boards);
+
+    // i 番目の盤面を書き込む
+    void set(int i, const BitBoard& board) {
+        for (int y = 0; y < Board::HEIGHT; ++y) rows[y * stride + i] = board.rows[y];
+    }
+};
+
+// ==== 1つの盤面の特徴量 ====
+struct BoardFeatures {
+    int aggregateHeight = 0, holes = 0, bumpiness = 0, wells = 0, rowTransitions = 0, columnTransitions = 0;
+};
+
+// ==== 特徴量（これも盤面ごとの配列） ====
+struct BatchFeatures {
+    std::vector<std::int16_t> aggregateHeight, holes, bumpiness, wells, rowTransitions, columnTransitions;
+
+    BoardFeatures at(int i) const {
+        return BoardFeatures{ aggregateHeight[i], holes[i], bumpiness[i], wells[i], rowTransitions[i], columnTransitions[i] };
+    }
+};
+
+// batch のすべての盤面の特徴量を out に書く（out の各配列は batch.stride 個になる）
+void evaluateBatch(const BoardBatch& batch, BatchFeatures& out);
+
+// 1つの盤面の特徴量をスカラーで計算する（カーネルと同じ定義）
+BoardFeatures computeBoardFeatures(const BitBoard& board);
+
+// 実行時に選ばれたカーネルの名前（"avx2" / "sse2" / "scalar"）
+const char* batchKernelName();
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 行や列のビット列を扱うための小さな関数（コンパイラの組み込み命令を使う）
+
+// 立っているビットの数
+inline int bitCount(std::uint32_t bits) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt(bits));
+#else
+    return __builtin_popcount(bits);
+#endif
+}
+
+// 一番下の立っているビットの位置（bits != 0 であること）
+inline int lowestBit(std::uint32_t bits) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, bits);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(bits);
+#endif
+}
+
+// 値を表すのに必要なビット数（0 なら 0、1 なら 1、2〜3 なら 2 …）
+inline int bitWidth(std::uint64_t value) {
+    if (value == 0) return 0;
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse64(&index, value);
+    return static_cast<int>(index) + 1;
+#else
+    return 64 - __builtin_clzll(value);
+#endif
+}
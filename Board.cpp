@@ -1,144 +1,192 @@
 #include "Board.hpp"
+#include <algorithm>
 
-// Blockクラスのコンストラクタ
-Block::Block(bool f, sf::Color c) : filled(f), color(c) {}
-
-// ブロックを描画する
-void Block::draw(sf::RenderWindow& window, int x, int y, int size) {
-    // 枠付きで描画するため、1px 小さくしている
-    sf::RectangleShape rect(sf::Vector2f(size - 1, size - 1));
-    rect.setPosition(x, y);
-    rect.setFillColor(filled ? color : sf::Color(30, 30, 30)); // 空は濃いグレー
-    window.draw(rect);
+// Boardのコンストラクタ（空の盤面を作る）
+template <int W, int H, int V>
+BasicBoard<W, H, V>::BasicBoard(bool withColors) {
+    if (withColors) colors.assign(WIDTH * HEIGHT, sf::Color::Black);
 }
 
-// Boardのコンストラクタ（空の20×10盤面を作る）
-Board::Board() {
-    grid.resize(HEIGHT, std::vector<Block>(WIDTH));
+// ==================== BitBoard クラス ====================
+// (x, y) の1マスを埋める
+template <int W, int H, int V>
+void BasicBitBoard<W, H, V>::placeCell(int x, int y) {
+    Row bit = static_cast<Row>(1u << x);
+    if (rows[y] & bit) return;
+    hash ^= ZOBRIST.cell[y][x];
+    addCells(y, bit);
+    rows[y] |= bit;
 }
 
-
-// 盤面全体を描画（左下が(0,0)）
-void Board::draw(sf::RenderWindow& window) {
-    for (int y = 0; y < HEIGHT; ++y) {
-        for (int x = 0; x < WIDTH; ++x) {
-            int drawY = (HEIGHT - 1 - y);
-            grid[y][x].draw(window, x * 40, drawY * 40);
-        }
+// ピースの形をビットマスクのまま配置する（1マスずつ置くより速い）
+template <int W, int H, int V>
+void BasicBitBoard<W, H, V>::placeMask(const PieceMask& m, int x, int y) {
+    int left = x + m.minX;
+    for (int i = 0; i < m.height; ++i) {
+        int row = y + m.minY + i;
+        if (row < 0 || row >= HEIGHT) continue;
+        Row bits = static_cast<Row>((m.mask[i] << left) & FULL_ROW);
+        Row added = static_cast<Row>(bits & ~rows[row]);
+        hash ^= rowHash(row, added);
+        addCells(row, added);
+        rows[row] |= bits;
     }
 }
 
-// 指定座標にブロックがあるかどうかを判定
-bool Board::isOccupied(int x, int y) {
-    // 横がはみ出したらtrue（移動できない）
-    if (x < 0 || x >= WIDTH || y >= HEIGHT) return true;
-    // 下側（y < 0）は盤面外なのでfalse
-    if (y < 0) return false;
-
-    // 座標反転してチェック
-    int gridY = HEIGHT - 1 - y;
-    return grid[gridY][x].filled;
-}
-
-// 指定座標にブロックを配置する
-void Board::placeBlock(int x, int y, sf::Color color) {
-    if (x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT) {
-        int gridY = HEIGHT - 1 - y;  // ← 反転
-        grid[gridY][x].filled = true;
-        grid[gridY][x].color = color;
+// 新しく埋まったマスの分だけ、列の高さとマスの数を更新する
+template <int W, int H, int V>
+void BasicBitBoard<W, H, V>::addCells(int y, Row bits) {
+    cellCount += bitCount(bits);
+    int h = HEIGHT - y;
+    for (unsigned b = bits; b; b &= b - 1) {
+        int x = lowestBit(b);
+        if (heights[x] < h) {
+            aggregateHeight += h - heights[x];
+            heights[x] = static_cast<std::uint8_t>(h);
+        }
     }
+}
 
-    print();
+// 列 x の一番上のブロックを fromY 行目から下へ探す
+template <int W, int H, int V>
+int BasicBitBoard<W, H, V>::scanHeight(int x, int fromY) const {
+    for (int y = fromY; y < HEIGHT; ++y)
+        if ((rows[y] >> x) & 1u) return HEIGHT - y;
+    return 0;
 }
 
 // 揃ったラインを削除し、削除した行数を返す
-int Board::clearLines() {
-    int linesCleared = 0;
-
-    // 下から上にチェックする（左下原点: y=0 が一番下(になるはずだったが多分左上が(0, 0)になってる)）
-    for (int y = 0; y < HEIGHT; ++y) {
-        bool full = true;
-        for (int x = 0; x < WIDTH; ++x) {
-            if (!grid[y][x].filled) full = false;
+// 積まれている範囲（一番高い列より下）の行だけを見るので、空の上側は触らない
+template <int W, int H, int V>
+int BasicBitBoard<W, H, V>::clearLines(std::uint64_t* clearedRows) {
+    int top = HEIGHT;
+    for (int x = 0; x < WIDTH; ++x) top = std::min(top, HEIGHT - heights[x]);
+
+    // 下から上へ、揃っていない行だけを詰めて書き戻す
+    std::uint64_t cleared = 0;
+    int write = HEIGHT - 1;
+    for (int y = HEIGHT - 1; y >= top; --y) {
+        if (rows[y] == FULL_ROW) {
+            hash ^= rowHash(y, FULL_ROW);
+            cleared |= std::uint64_t(1) << y;
+            continue;
         }
-
-        if (full) {
-            ++linesCleared;
-
-            // この行を削除し、上の行を下に落とす
-            for (int row = y; row < HEIGHT - 1; ++row) {
-                for (int x = 0; x < WIDTH; ++x) {
-                    grid[row][x] = grid[row + 1][x];
-                }
-            }
-
-            // 一番上の行を空にする
-            for (int x = 0; x < WIDTH; ++x)
-                grid[HEIGHT - 1][x] = Block(false, sf::Color::Black);
-
-            // 同じ行 y を再チェック（連続消去対応）
-            --y;
+        if (write != y) {
+            // 行が下にずれるので、元の位置のハッシュを抜いて新しい位置で入れ直す
+            hash ^= rowHash(y, rows[y]) ^ rowHash(write, rows[y]);
+            rows[write] = rows[y];
         }
+        --write;
+    }
+    if (clearedRows) *clearedRows = cleared;
+
+    // 消した行数ぶん、積まれていた範囲の一番上を空にする
+    int linesCleared = write - top + 1;
+    if (linesCleared == 0) return 0;
+    for (int y = top; y <= write; ++y) rows[y] = 0;
+
+    // 列の情報：揃った行はどの列でも埋まっているので、どの列も linesCleared 段低くなる
+    // ただし一番上のブロックが消えた列は、その下に空きがあるかもしれないので探し直す
+    cellCount -= linesCleared * WIDTH;
+    aggregateHeight = 0;
+    for (int x = 0; x < WIDTH; ++x) {
+        int h = heights[x] - linesCleared;
+        if ((cleared >> (HEIGHT - heights[x])) & 1u) h = scanHeight(x, HEIGHT - h);
+        heights[x] = static_cast<std::uint8_t>(h);
+        aggregateHeight += h;
     }
 
     return linesCleared;
 }
 
-// ターミナルに盤面を出力する
-void Board::print() {
-#ifdef _WIN32
-    system("cls");   // Windows
-#else
-    system("clear"); // macOS / Linux
-#endif
-
-    //std::cout << "===== BOARD =====" << std::endl;
+// rows からハッシュを計算し直す
+template <int W, int H, int V>
+void BasicBitBoard<W, H, V>::rehash() {
+    hash = 0;
+    for (int y = 0; y < HEIGHT; ++y) hash ^= rowHash(y, rows[y]);
+
+    cellCount = 0;
+    aggregateHeight = 0;
+    for (int x = 0; x < WIDTH; ++x) {
+        heights[x] = static_cast<std::uint8_t>(scanHeight(x, 0));
+        aggregateHeight += heights[x];
+    }
+    for (int y = 0; y < HEIGHT; ++y) cellCount += bitCount(rows[y]);
+}
 
-    for (int y = HEIGHT - 1; y >= 0; --y) {
-        bool fullLine = true;
-        for (int x = 0; x < WIDTH; ++x) {
-            if (!grid[y][x].filled) {
-                fullLine = false;
-                break;
-            }
-        }
+// ==================== Board クラス ====================
+// 指定座標にブロックを配置する
+template <int W, int H, int V>
+void BasicBoard<W, H, V>::placeBlock(int x, int y, sf::Color color) {
+    if (x >= 0 && x < WIDTH && y >= 0 && y < HEIGHT) {
+        this->placeCell(x, y);
+        if (!colors.empty()) colors[y * WIDTH + x] = color;
+        ++revision;
+    }
+}
 
-        // すべて埋まっている行はスキップ
-        if (fullLine) continue;
+// ピースを置いて、置いたマスに色を塗る
+template <int W, int H, int V>
+void BasicBoard<W, H, V>::placeMask(const PieceMask& m, int x, int y, sf::Color color) {
+    ++revision;
+    Base::placeMask(m, x, y);
+    if (colors.empty()) return;
+    int left = x + m.minX;
+    for (int i = 0; i < m.height; ++i) {
+        int row = y + m.minY + i;
+        if (row < 0 || row >= HEIGHT) continue;
+        unsigned bits = (m.mask[i] << left) & FULL_ROW;
+        for (; bits; bits &= bits - 1) colors[row * WIDTH + lowestBit(bits)] = color;
+    }
+}
 
-        // 通常表示
-        std::cout << "|";
-        for (int x = 0; x < WIDTH; ++x) {
-            std::cout << (grid[y][x].filled ? "X" : "_");
+// ライン消去：占有情報は BitBoard に任せ、消した行に合わせて色の行も詰める
+template <int W, int H, int V>
+int BasicBoard<W, H, V>::clearLines() {
+    std::uint64_t cleared = 0;
+    int linesCleared = Base::clearLines(&cleared);
+    if (linesCleared == 0) return 0;
+    ++revision;
+    if (!colors.empty()) {
+        int write = HEIGHT - 1;
+        for (int y = HEIGHT - 1; y >= 0; --y) {
+            if ((cleared >> y) & 1u) continue;
+            if (write != y) std::copy_n(&colors[y * WIDTH], WIDTH, &colors[write * WIDTH]);
+            --write;
         }
-        std::cout << "|" << std::endl;
+        std::fill_n(colors.begin(), (write + 1) * WIDTH, sf::Color::Black);
     }
+    return linesCleared;
+}
 
-    //std::cout << "+" << std::string(WIDTH, '-') << "+" << std::endl;
+template <int W, int H, int V>
+void BasicBoard<W, H, V>::rehash() {
+    ++revision;
+    Base::rehash();
 }
 
 // 盤面を文字列として返す
-std::string Board::toString() const {
+template <int W, int H, int V>
+std::string BasicBitBoard<W, H, V>::toString() const {
     std::string result;
+    result.reserve(HEIGHT * (WIDTH + 3));
 
-    for (int y = HEIGHT - 1; y >= 0; --y) {
-        bool fullLine = true;
-        for (int x = 0; x < WIDTH; ++x) {
-            if (!grid[y][x].filled) {
-                fullLine = false;
-                break;
-            }
-        }
-
+    for (int y = 0; y < HEIGHT; ++y) {
         // すべて埋まっている行はスキップ
-        if (fullLine) continue;
+        if (rows[y] == FULL_ROW) continue;
 
-        result += "|";
+        result += '|';
         for (int x = 0; x < WIDTH; ++x) {
-            result += (grid[y][x].filled ? "X" : "_");
+            result += ((rows[y] >> x) & 1u) ? 'X' : '_';
         }
         result += "|\n";
     }
 
     return result;
 }
+
+// ゲームで使う大きさの実体（別の大きさを使うときはここに足す）
+template class BasicBitBoard<10, 20>;
+template class BasicBitBoard<10, 40, 20>;
+template class BasicBoard<10, 20>;
+template class BasicBoard<10, 40, 20>;
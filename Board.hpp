@@ -1,47 +1,189 @@
-#pragma once 
-#include<iostream>
-#include <cstdlib> // for system()
-#include <vector> 
-#include <SFML/Graphics.hpp> 
-
-// 1マスを表すクラス
-class Block {
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include <array>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "SrsTables.hpp"
+#include "Zobrist.hpp"
+#include "BitOps.hpp"
+
+// 1行 W 列のビット列を入れる整数型（入る中で一番小さいもの）
+template <int W>
+using BoardRow = std::conditional_t<(W <= 8), std::uint8_t,
+    std::conditional_t<(W <= 16), std::uint16_t,
+    std::conditional_t<(W <= 32), std::uint32_t, std::uint64_t>>>;
+
+// 盤面の占有情報だけを持つクラス（色や描画の情報を持たないので、そのままコピーできる）
+// 占有情報は1行を1ワードのビット列（bit x が列 x）で持つ
+// y は Piece と同じく 0 が一番上、HEIGHT - 1 が一番下
+// 探索（MoveGenerator・ボット・perft）はこれだけを使い、色つきの Board はこれを継承する
+//
+// 盤面の大きさはテンプレート引数で決まる（W 列 × H 行、そのうち下の VISIBLE 行が画面に見える範囲）
+// 上の H - VISIBLE 行は見えないバッファで、ピースの出現や回転で上にはみ出した分を受け止める
+// 行の整数型とループの回数がコンパイル時に決まるので、大きさごとに専用のコードになる
+// 盤面の外（左右・床・一番上の行より上）はすべて壁として扱う（isOccupied / overlaps / Piece::collides で共通）
+//
+// 外に置いた関数は Board.cpp で使う大きさの分だけ実体化している（別の大きさを使うときはそこに1行足す）
+template <int W, int H, int VISIBLE = H>
+class BasicBitBoard {
 public:
-    bool filled;          // ブロックが埋まっているかどうか
-    sf::Color color;      // ブロックの色
+    static_assert(W >= 4 && W <= ZobristKeys::MAX_WIDTH, "board width must fit the Zobrist key table");
+    static_assert(H >= 4 && H <= ZobristKeys::MAX_HEIGHT && H <= 64, "cleared rows are tracked in a 64-bit mask");
+    static_assert(VISIBLE > 0 && VISIBLE <= H, "visible rows must be part of the board");
 
-    // コンストラクタ（デフォルトは空で黒色）
-    Block(bool f = false, sf::Color c = sf::Color::Black);
+    static constexpr int WIDTH = W;                 // 横幅（列数）
+    static constexpr int HEIGHT = H;                // 縦幅（隠れた行も含めた行数）
+    static constexpr int VISIBLE_HEIGHT = VISIBLE;  // 画面に見える行数（下から）
+    static constexpr int HIDDEN_ROWS = H - VISIBLE; // 見えない上側のバッファの行数
 
-    // ブロックを描画する
-    void draw(sf::RenderWindow& window, int x, int y, int size = 40);
-};
+    // 1行分の占有ビット
+    using Row = BoardRow<W>;
+    static constexpr Row FULL_ROW = static_cast<Row>((std::uint64_t(1) << WIDTH) - 1);
 
-// テトリスの盤面を表すクラス
-class Board {
-public:
-    static const int WIDTH = 10;   // 横幅（列数）
-    static const int HEIGHT = 20;  // 縦幅（行数）
+    // 盤面データ（rows[y] が y 行目の占有ビット）
+    std::array<Row, HEIGHT> rows{};
+    // 埋まっているマスの Zobrist ハッシュ（placeMask / clearLines で更新される）
+    // rows を直接書き換えたときは rehash() で計算し直すこと（下の列の情報もまとめて計算し直す）
+    std::uint64_t hash = 0;
+    // 列ごとの高さ（一番上のブロックの上端が床から何段目か、空なら 0）
+    // hash と同じく placeMask / clearLines で差分だけ更新される
+    std::array<std::uint8_t, WIDTH> heights{};
+    int aggregateHeight = 0;                 // heights の合計
+    int cellCount = 0;                       // 埋まっているマスの数
 
-    // 盤面データ（高さ×幅の2次元配列）
-    std::vector<std::vector<Block>> grid;
     std::string toString() const; //盤面返却用
 
-    // コンストラクタ（空の盤面を作成）
-    Board();
+    // 指定座標が埋まっているかどうかを判定（盤面の外はすべて true）
+    bool isOccupied(int x, int y) const {
+        if (static_cast<unsigned>(x) >= static_cast<unsigned>(WIDTH) || static_cast<unsigned>(y) >= static_cast<unsigned>(HEIGHT))
+            return true;
+        return (rows[y] >> x) & 1u;
+    }
+
+    // ピースの形（行ごとのビットマスク）を (x, y) に置くと壁・床・天井・ブロックと重なるか
+    bool overlaps(const PieceMask& m, int x, int y) const {
+        int left = x + m.minX;
+        if (left < 0 || left + m.width > WIDTH) return true;
+        int top = y + m.minY;
+        if (top < 0 || top + m.height > HEIGHT) return true;
+        for (int i = 0; i < m.height; ++i)
+            if (rows[top + i] & (m.mask[i] << left)) return true;
+        return false;
+    }
+
+    // ピースの形を (x, y) からまっすぐ何段落とせるか（(x, y) では重なっていないこと）
+    // ピースの各列の一番下のマスが、その列の一番上のブロックより上にあれば heights だけで決まる
+    // 張り出しの下に潜り込んでいる列があるときだけ、1段ずつ確かめる
+    int dropDistance(const PieceMask& m, int x, int y) const {
+        int left = x + m.minX, top = y + m.minY;
+        int distance = HEIGHT - top;   // どの列の値もこれより小さい
+        for (int j = 0; j < m.width; ++j) {
+            int bottomRow = top + m.bottom[j];
+            int surface = HEIGHT - heights[left + j];
+            if (bottomRow >= surface) {
+                distance = 0;
+                while (!overlaps(m, x, y + distance + 1)) ++distance;
+                return distance;
+            }
+            distance = std::min(distance, surface - bottomRow - 1);
+        }
+        return distance;
+    }
+
+    // y 行目の埋まっているマスの数
+    int rowFill(int y) const { return bitCount(rows[y]); }
 
-    // 盤面を描画する
-    void draw(sf::RenderWindow& window);
+    // 穴（上に同じ列のブロックがある空きマス）の数
+    // 各列の高さまでのマスのうち埋まっていないものなので、高さの合計 - マスの数 で求まる
+    int holes() const { return aggregateHeight - cellCount; }
 
-    // 指定座標が埋まっているかどうかを判定
-    bool isOccupied(int x, int y);
+    // 隣り合う列の高さの差の合計
+    int bumpiness() const {
+        int sum = 0;
+        for (int x = 0; x + 1 < WIDTH; ++x) sum += std::abs(heights[x] - heights[x + 1]);
+        return sum;
+    }
+
+    // ピースの形（行ごとのビットマスク）を (x, y) にまとめて配置する（盤面外の行は捨てる）
+    void placeMask(const PieceMask& m, int x, int y);
+
+    // そろったラインを消去し、消した行数を返す
+    // clearedRows を渡すと、消した行（消す前の y）のビットを立てて返す
+    int clearLines(std::uint64_t* clearedRows = nullptr);
+
+    // rows からハッシュと列の情報を計算し直す
+    void rehash();
+
+    // y 行目のビット列 bits に対応するハッシュ
+    static std::uint64_t rowHash(int y, Row bits) {
+        std::uint64_t h = 0;
+        for (std::uint32_t b = bits; b; b &= b - 1) h ^= ZOBRIST.cell[y][lowestBit(b)];
+        return h;
+    }
+
+protected:
+    // (x, y) の1マスを埋める（すでに埋まっていれば何もしない）
+    void placeCell(int x, int y);
+    // y 行目に新しく埋まったマス bits の分だけ列の情報を更新する
+    void addCells(int y, Row bits);
+    // 列 x の高さを y 行目から下に向かって探し直す
+    int scanHeight(int x, int fromY) const;
+};
+
+// テトリスの盤面を表すクラス（BasicBitBoard に描画用の色を足したもの）
+template <int W, int H, int VISIBLE = H>
+class BasicBoard : public BasicBitBoard<W, H, VISIBLE> {
+public:
+    using Base = BasicBitBoard<W, H, VISIBLE>;
+    using Base::WIDTH;
+    using Base::HEIGHT;
+    using Base::HIDDEN_ROWS;
+    using Base::FULL_ROW;
+    using Base::rows;
+
+    // 色データ（描画用、y * WIDTH + x）。空なら色は記録しない（ヘッドレス用）
+    std::vector<sf::Color> colors;
+    // 盤面が変わるたびに増える番号（描画のキャッシュが作り直しの要否を判定する）
+    std::uint32_t revision = 0;
+
+    // コンストラクタ（空の盤面を作成）。withColors = false で色の記録を省略する
+    BasicBoard(bool withColors = true);
+
+    // 指定座標の色（色を記録していない場合は白）
+    sf::Color colorAt(int x, int y) const {
+        return colors.empty() ? sf::Color::White : colors[y * WIDTH + x];
+    }
 
     // 指定座標にブロックを配置する
     void placeBlock(int x, int y, sf::Color color);
 
-    // そろったラインを消去し、消した行数を返す
+    // ピースの形を (x, y) にまとめて配置し、色も塗る
+    void placeMask(const PieceMask& m, int x, int y, sf::Color color);
+
+    // そろったラインを消去し、消した行数を返す（色の行も一緒にずらす）
     int clearLines();
 
-    //盤面の出力
-    void print();
+    // rows からハッシュと列の情報を計算し直す
+    void rehash();
 };
+
+// ==== ゲームで使う盤面 ====
+// 10 × 20（隠れた行なし）。ゲーム・探索・リプレイ・C API はこの大きさを使う
+using BitBoard = BasicBitBoard<10, 20>;
+using Board = BasicBoard<10, 20>;
+
+// 10 × 40（下の20行が見える範囲、上の20行がバッファ）
+using BufferedBitBoard = BasicBitBoard<10, 40, 20>;
+using BufferedBoard = BasicBoard<10, 40, 20>;
+
+// 外に置いた関数の実体は Board.cpp にある
+extern template class BasicBitBoard<10, 20>;
+extern template class BasicBitBoard<10, 40, 20>;
+extern template class BasicBoard<10, 20>;
+extern template class BasicBoard<10, 40, 20>;
+
+static_assert(std::is_trivially_copyable<BitBoard>::value, "BitBoard is copied with memcpy during search");
+static_assert(std::is_trivially_copyable<BufferedBitBoard>::value, "BufferedBitBoard must be trivially copyable like BitBoard");
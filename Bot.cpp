@@ -0,0 +1,296 @@
+#include "Bot.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+namespace {
+    // 置ける位置が1つもない（積み上がって終わる）局面の値
+    const double TOP_OUT_SCORE = -1.0e6;
+}
+
+// 盤面の評価値（ライン消去の得点は探索側で足すので、ここでは形だけを見る）
+// 高さ・穴・凸凹は Board が置く・消すたびに差分で更新しているので、ここでは読むだけ
+// 形の特徴量を使う重みのときだけ盤面を走査する
+double evaluateBoard(const BitBoard& board, const EvalWeights& weights) {
+    if (weights.usesShapeFeatures()) return scoreFeatures(computeBoardFeatures(board), weights);
+    return weights.aggregateHeight * board.aggregateHeight + weights.holes * board.holes()
+        + weights.bumpiness * board.bumpiness();
+}
+
+double scoreFeatures(const BoardFeatures& f, const EvalWeights& weights) {
+    return weights.aggregateHeight * f.aggregateHeight + weights.holes * f.holes + weights.bumpiness * f.bumpiness
+        + weights.wells * f.wells + weights.rowTransitions * f.rowTransitions
+        + weights.columnTransitions * f.columnTransitions;
+}
+
+// コンストラクタ：スレッドプールとワーカーごとの作業領域を用意する
+BeamSearchBot::BeamSearchBot(const BotConfig& config)
+    : config(config), table(config.ttBits), chanceTable(config.ttBits)
+{
+    if (config.threads != 1) pool = std::make_unique<ThreadPool>(config.threads);
+    int slots = pool ? pool->size() + 1 : 1;
+    generators.resize(slots);
+    placementBuffers.resize(slots);
+    freshChildren.resize(slots);
+    batches.resize(slots);
+    batchFeatures.resize(slots);
+    chanceScratch.assign(slots, std::vector<ChanceScratch>(std::max(config.chanceDepth, 0)));
+}
+
+// node から1手進めた子を out に追加する
+void BeamSearchBot::expand(const Node& node, const std::vector<PieceType>& sequence, bool holdAvailable,
+    int depth, int worker, std::vector<Node>& out, std::vector<RootMove>* rootMoves) {
+    if (node.cursor >= static_cast<int>(sequence.size())) return;
+
+    MoveGenerator& gen = generators[worker];
+    std::vector<Placement>& placements = placementBuffers[worker];
+    std::vector<Node>& fresh = freshChildren[worker];
+    const EvalWeights& w = config.weights;
+
+    // piece を置けるすべての位置について子を作る
+    auto play = [&](PieceType piece, int newHold, int newCursor, bool usedHold) {
+        int nextPiece = newCursor < static_cast<int>(sequence.size()) ? static_cast<int>(sequence[newCursor]) : 0;
+        gen.generate(node.board, piece, placements);
+        fresh.resize(placements.size());
+        for (std::size_t i = 0; i < placements.size(); ++i) {
+            Node& child = fresh[i];
+            child.board = node.board;
+            int lines = applyPlacement(child.board, placements[i]);
+            child.reward = node.reward + w.linesCleared * lines;
+            child.cursor = newCursor;
+            child.hold = newHold;
+        }
+
+        // 評価：形の特徴量を使うなら、候補の盤面をまとめて SIMD のカーネルに渡す
+        if (w.usesShapeFeatures()) {
+            BoardBatch& batch = batches[worker];
+            batch.reset(static_cast<int>(fresh.size()));
+            for (std::size_t i = 0; i < fresh.size(); ++i) batch.set(static_cast<int>(i), fresh[i].board);
+            evaluateBatch(batch, batchFeatures[worker]);
+            for (std::size_t i = 0; i < fresh.size(); ++i)
+                fresh[i].score = fresh[i].reward + scoreFeatures(batchFeatures[worker].at(static_cast<int>(i)), w);
+        }
+        else {
+            for (auto& child : fresh) child.score = child.reward + evaluateBoard(child.board, w);
+        }
+
+        for (std::size_t i = 0; i < fresh.size(); ++i) {
+            Node& child = fresh[i];
+            const Placement& p = placements[i];
+
+            // 別の順番で同じ状態（盤面・Hold・Nextの位置）にすでに同じ以上の評価で到達していれば捨てる
+            std::uint64_t key = searchStateHash(child.board.hash, nextPiece, newHold, newCursor);
+            TranspositionTable::Entry seen;
+            if (table.probe(key, seen) && seen.score >= static_cast<float>(child.score)) continue;
+            table.store(key, TranspositionTable::Entry{ static_cast<float>(child.score), static_cast<std::uint16_t>(depth), 0 });
+            if (rootMoves) {
+                child.root = static_cast<int>(rootMoves->size());
+                rootMoves->push_back(RootMove{ p, usedHold });
+            }
+            else {
+                child.root = node.root;
+            }
+            out.push_back(child);
+        }
+    };
+
+    PieceType current = sequence[node.cursor];
+    play(current, node.hold, node.cursor + 1, false);
+
+    // --- Hold を使う手 ---
+    if (config.useHold && holdAvailable) {
+        if (node.hold >= 0) {
+            // Hold 中のピースと入れ替える（同じ種類なら置ける位置も同じなので省く）
+            if (node.hold != static_cast<int>(current))
+                play(static_cast<PieceType>(node.hold), static_cast<int>(current), node.cursor + 1, true);
+        }
+        else if (node.cursor + 1 < static_cast<int>(sequence.size())) {
+            // Hold が空なら、次のピースを先に使う
+            play(sequence[node.cursor + 1], static_cast<int>(current), node.cursor + 2, true);
+        }
+    }
+}
+
+// 次のピースが袋 bag から出る局面の値
+// 各種類について「Hold と入れ替える手も含めて一番良い置き方」の値を求め、等確率で平均する
+// Hold が空の局面で Hold すると、その次のピースもまだ分からないので、その手はここでは読まない
+double BeamSearchBot::chanceValue(const BitBoard& board, int hold, std::uint8_t bag, int depth, int worker) {
+    std::uint64_t key = chanceStateHash(board.hash, hold, bag);
+    TranspositionTable::Entry seen;
+    if (chanceTable.probe(key, seen) && seen.depth == depth) return seen.score;
+
+    const EvalWeights& w = config.weights;
+    MoveGenerator& gen = generators[worker];
+    ChanceScratch& scratch = chanceScratch[worker][depth - 1];
+
+    double total = 0.0;
+    int outcomes = 0;
+    for (int t = 0; t < 7; ++t) {
+        if (!((bag >> t) & 1u)) continue;
+        ++outcomes;
+
+        // 種類 t が出たときの子をすべて作る
+        scratch.children.clear();
+        auto addChildren = [&](int piece, int newHold) {
+            gen.generate(board, static_cast<PieceType>(piece), scratch.placements);
+            for (const Placement& p : scratch.placements) {
+                ChanceChild child;
+                child.board = board;
+                child.hold = newHold;
+                child.reward = w.linesCleared * applyPlacement(child.board, p);
+                child.score = child.reward + evaluateBoard(child.board, w);
+                scratch.children.push_back(child);
+            }
+        };
+        addChildren(t, hold);
+        if (config.useHold && hold >= 0 && hold != t) addChildren(hold, t);
+
+        // 一番良い置き方の値（さらに先を読むなら、評価の高い chanceBranch 個だけを読む）
+        double best = scratch.children.empty() ? TOP_OUT_SCORE : -std::numeric_limits<double>::infinity();
+        if (depth == 1) {
+            for (const auto& child : scratch.children) best = std::max(best, child.score);
+        }
+        else {
+            std::uint8_t nextBag = bagAfterDraw(bag, static_cast<PieceType>(t));
+            int keep = std::min(config.chanceBranch, static_cast<int>(scratch.children.size()));
+            std::partial_sort(scratch.children.begin(), scratch.children.begin() + keep, scratch.children.end(),
+                [](const ChanceChild& a, const ChanceChild& b) { return a.score > b.score; });
+            // 再帰は1つ浅い作業領域を使うので、scratch.children はそのまま読める
+            for (int i = 0; i < keep; ++i) {
+                const ChanceChild& child = scratch.children[i];
+                best = std::max(best, child.reward + chanceValue(child.board, child.hold, nextBag, depth - 1, worker));
+            }
+        }
+        total += best;
+    }
+
+    // 表には float で入るので、計算したときも同じ float に丸めて返す
+    // （表に残っているかどうかで値が変わると、局の順番やスレッド数で選ぶ手が変わってしまう）
+    float value = static_cast<float>(outcomes > 0 ? total / outcomes : TOP_OUT_SCORE);
+    chanceTable.store(key, TranspositionTable::Entry{ value, static_cast<std::uint16_t>(depth), 0 });
+    return value;
+}
+
+// ビームサーチで次の1手を選ぶ
+BotDecision BeamSearchBot::decide(const BitBoard& board, PieceType current, const std::deque<PieceType>& next,
+    std::optional<PieceType> hold, bool holdAvailable, std::uint8_t bag) {
+    using Clock = std::chrono::steady_clock;
+    const auto deadline = Clock::now() + std::chrono::microseconds(config.timeBudgetUs);
+    auto timeUp = [&] { return config.timeBudgetUs > 0 && Clock::now() >= deadline; };
+
+    // 読むピースの並び（現在のピース + Next、最大 maxDepth 個）
+    std::vector<PieceType> sequence{ current };
+    for (PieceType p : next) {
+        if (static_cast<int>(sequence.size()) >= config.maxDepth) break;
+        sequence.push_back(p);
+    }
+
+    Node root;
+    root.board = board;
+    root.hold = hold ? static_cast<int>(*hold) : -1;
+
+    // --- 最初の1手はすべて展開する（時間切れでも必ず1手は返す） ---
+    const int self = static_cast<int>(generators.size()) - 1;
+    std::vector<RootMove> rootMoves;
+    std::vector<Node> beam, nextBeam;
+    table.newGeneration();
+    expand(root, sequence, holdAvailable, 0, self, beam, &rootMoves);
+
+    BotDecision decision;
+    if (beam.empty()) return decision;
+    decision.depthReached = 1;
+
+    // 評価の高い上位 beamWidth 個だけを残す
+    auto select = [&](std::vector<Node>& nodes) {
+        if (static_cast<int>(nodes.size()) <= config.beamWidth) return;
+        std::nth_element(nodes.begin(), nodes.begin() + (config.beamWidth - 1), nodes.end(),
+            [](const Node& a, const Node& b) { return a.score > b.score; });
+        nodes.resize(config.beamWidth);
+    };
+    select(beam);
+
+    // --- 2手目以降：ビームの各要素の展開をスレッドに分配する ---
+    for (int depth = 1; depth < config.maxDepth && !timeUp(); ++depth) {
+        children.resize(beam.size());
+        for (auto& c : children) c.clear();
+
+        std::atomic<bool> aborted{ false };
+        auto task = [&](int i, int worker) {
+            if (aborted.load(std::memory_order_relaxed)) return;
+            if (timeUp()) {
+                aborted.store(true, std::memory_order_relaxed);
+                return;
+            }
+            expand(beam[i], sequence, true, depth, worker, children[i], nullptr);
+        };
+        if (pool) pool->parallelFor(static_cast<int>(beam.size()), task);
+        else for (int i = 0; i < static_cast<int>(beam.size()); ++i) task(i, self);
+
+        // 読み切れなかった深さは捨て、1つ前のビームで決める
+        if (aborted.load()) break;
+
+        nextBeam.clear();
+        bool expandable = false;
+        for (std::size_t i = 0; i < beam.size(); ++i) {
+            // Hold で先に使い切ってもう置くピースがない要素は、そのまま残して比べる
+            if (beam[i].cursor >= static_cast<int>(sequence.size())) nextBeam.push_back(beam[i]);
+            else expandable = true;
+            nextBeam.insert(nextBeam.end(), children[i].begin(), children[i].end());
+        }
+        if (!expandable || nextBeam.empty()) break;
+
+        select(nextBeam);
+        beam.swap(nextBeam);
+        decision.depthReached = depth + 1;
+    }
+
+    // --- 最も評価の高い並びの最初の1手を選ぶ ---
+    const Node* best = &*std::max_element(beam.begin(), beam.end(),
+        [](const Node& a, const Node& b) { return a.score < b.score; });
+    double bestScore = best->score;
+
+    // --- Next を読み切っていれば、上位の並びをその先の見えないピースまで期待値で読み直す ---
+    bool previewConsumed = sequence.size() == next.size() + 1
+        && std::all_of(beam.begin(), beam.end(), [&](const Node& n) { return n.cursor >= static_cast<int>(sequence.size()); });
+    if (config.chanceDepth > 0 && previewConsumed && !timeUp()) {
+        int count = std::min(config.chanceWidth, static_cast<int>(beam.size()));
+        std::partial_sort(beam.begin(), beam.begin() + count, beam.end(),
+            [](const Node& a, const Node& b) { return a.score > b.score; });
+        std::vector<double> values(count);
+        auto task = [&](int i, int worker) {
+            values[i] = beam[i].reward + chanceValue(beam[i].board, beam[i].hold, bag, config.chanceDepth, worker);
+        };
+        if (pool) pool->parallelFor(count, task);
+        else for (int i = 0; i < count; ++i) task(i, self);
+
+        int pick = static_cast<int>(std::max_element(values.begin(), values.end()) - values.begin());
+        best = &beam[pick];
+        bestScore = values[pick];
+        decision.chanceLeaves = count;
+    }
+    const RootMove& move = rootMoves[best->root];
+
+    decision.found = true;
+    decision.useHold = move.useHold;
+    decision.placement = move.placement;
+    decision.score = bestScore;
+
+    // 操作列：必要なら Hold、そのあと元の盤面でキーを押す回数が一番少ない列を求める
+    if (move.useHold) decision.inputs.push_back(Action::Hold);
+    std::vector<Action> path = finesse.plan(root.board, move.placement);
+    if (path.empty()) {
+        generators[self].generate(root.board, move.placement.type, placementBuffers[self]);
+        path = generators[self].pathTo(move.placement);
+    }
+    decision.inputs.insert(decision.inputs.end(), path.begin(), path.end());
+    return decision;
+}
+
+// GameCore の今の状態から次の1手を選ぶ
+BotDecision BeamSearchBot::decide(const GameCore& core) {
+    GameState state = core.getGameState();
+    std::optional<PieceType> hold;
+    if (core.getHoldPiece()) hold = core.getHoldPiece()->type;
+    return decide(core.getBoard(), state.currentPiece, core.getNextQueue(), hold, !state.holdUsed, core.getUnseenBag());
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include "BatchEval.hpp"
+#include "Board.hpp"
+#include "Finesse.hpp"
+#include "Piece.hpp"
+#include "GameCore.hpp"
+#include "MoveGen.hpp"
+#include "ThreadPool.hpp"
+#include "Zobrist.hpp"
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
+// BeamSearchBot について
+// 現在のピース + Next（最大5個）+ Hold を使い、ビームサーチで次の1手を選ぶ自動プレイヤー
+// 各深さで「盤面の評価が高い上位 beamWidth 個」だけを残して次のピースを置いていき、
+// 最後まで残った中で最も評価の高い並びの最初の1手を返す
+// 候補の展開（MoveGenerator + 評価）はワークスティーリングのスレッドプールで全コアに分配する
+// 置く順番が違うだけで同じ状態になった子は、Zobrist ハッシュの置換表で見つけて捨てる
+//
+// Next を最後まで読み切ったら、評価の高い上位 chanceWidth 個の並びについて、その先の見えないピースを
+// 7種1巡の袋の残りから期待値で読む（expectimax）。次のピースは袋に残っている種類から等確率で出るので、
+// 「各種類について一番良い置き方の値」の平均をその局面の値とする
+// 見えない先の値は（盤面・Hold・袋の残り）だけで決まるので、別の置換表に覚えて手や局をまたいで使い回す
+// 表に入る float と同じ値に丸めてから使うので、表に残っていても計算し直しても同じ値になり、結果は変わらない
+
+// ==== 盤面評価の重み ====
+struct EvalWeights {
+    double aggregateHeight = -0.510066;   // 各列の高さの合計
+    double linesCleared = 0.760666;       // 消したライン数
+    double holes = -0.35663;              // 穴（上が埋まっている空きマス）の数
+    double bumpiness = -0.184483;         // 隣り合う列の高さの差の合計
+    // 形の特徴量（BatchEval.hpp の定義）。既定の重みでは使わない
+    double wells = 0.0;                   // 井戸のマスの数
+    double rowTransitions = 0.0;          // 行の埋まり・空きの入れ替わり
+    double columnTransitions = 0.0;       // 列の埋まり・空きの入れ替わり
+
+    // 形の特徴量を使うか（使うなら盤面を走査する必要がある）
+    bool usesShapeFeatures() const { return wells != 0.0 || rowTransitions != 0.0 || columnTransitions != 0.0; }
+};
+
+// 盤面の評価値（大きいほど良い）
+double evaluateBoard(const BitBoard& board, const EvalWeights& weights);
+
+// 特徴量から評価値を計算する
+double scoreFeatures(const BoardFeatures& f, const EvalWeights& weights);
+
+// ==== 探索の設定 ====
+struct BotConfig {
+    int beamWidth = 128;          // 各深さで残す盤面の数
+    int maxDepth = 6;             // 読む手数（現在のピース + Next の数まで）
+    int timeBudgetUs = 5000;      // 1回の思考時間の上限（マイクロ秒、0 なら無制限）
+    int threads = 0;              // 0 ならハードウェアのスレッド数、1 ならスレッドを使わない
+    bool useHold = true;          // Hold を使う手も探索するか
+    int ttBits = 18;              // 置換表の大きさ（2^ttBits エントリ）
+    int chanceDepth = 1;          // Next の先の見えないピースを何個まで期待値で読むか（0 なら読まない）
+    int chanceWidth = 16;         // 期待値で読み直す並びの数（ビームの上位から）
+    int chanceBranch = 4;         // 見えないピースを2個以上読むとき、1種類ごとに先を読む置き方の数
+    EvalWeights weights;
+};
+
+// ==== 探索の結果 ====
+struct BotDecision {
+    bool found = false;           // 置ける手が1つもなければ false
+    bool useHold = false;         // 最初に Hold するか
+    Placement placement{};        // 置く位置（Hold した場合は Hold から出てくるピース）
+    std::vector<Action> inputs;   // GameCore::step に順に渡す操作列（Hold を含む、キーを押す回数が最少）
+    double score = 0.0;           // 選んだ並びの評価値
+    int depthReached = 0;         // 時間内に読み切れた深さ
+    int chanceLeaves = 0;         // 見えないピースまで期待値で読んだ並びの数
+};
+
+class BeamSearchBot {
+public:
+    explicit BeamSearchBot(const BotConfig& config = BotConfig());
+
+    // 盤面・現在のピース・Next・Hold から次の1手を選ぶ
+    // holdAvailable が false なら（このターンで Hold 済みなら）最初の Hold は試さない
+    // bag は Next の後ろに続くピースが入っている袋（GameCore::getUnseenBag）
+    BotDecision decide(const BitBoard& board, PieceType current, const std::deque<PieceType>& next,
+        std::optional<PieceType> hold, bool holdAvailable, std::uint8_t bag = FULL_BAG);
+
+    // GameCore の今の状態から次の1手を選ぶ
+    BotDecision decide(const GameCore& core);
+
+    const BotConfig& getConfig() const { return config; }
+
+private:
+    // ビームの1要素
+    struct Node {
+        BitBoard board;           // 置いたあとの盤面（色は持たない）
+        double reward = 0.0;      // ここまでに消したラインの得点
+        double score = 0.0;       // reward + 盤面の評価（並べ替えに使う）
+        int cursor = 0;           // 次に使うピースの位置（sequence の添字）
+        int hold = -1;            // Hold 中の種類（-1 なら空）
+        int root = 0;             // 最初の1手（rootMoves の添字）
+    };
+
+    // 最初の1手の候補
+    struct RootMove {
+        Placement placement;
+        bool useHold;
+    };
+
+    // 見えないピースを置いた子
+    struct ChanceChild {
+        BitBoard board;
+        int hold = -1;
+        double reward = 0.0;      // この1手で消したラインの得点
+        double score = 0.0;       // reward + 盤面の評価
+    };
+
+    // 見えないピースを読むときの作業領域（ワーカーごと・残りの深さごと）
+    struct ChanceScratch {
+        std::vector<Placement> placements;
+        std::vector<ChanceChild> children;
+    };
+
+    BotConfig config;
+    std::unique_ptr<ThreadPool> pool;                    // threads == 1 なら作らない
+    std::vector<MoveGenerator> generators;               // ワーカーごと（呼び出し元の分を含む）
+    std::vector<std::vector<Placement>> placementBuffers;
+    std::vector<std::vector<Node>> children;             // ビームの要素ごとの展開結果
+    std::vector<std::vector<Node>> freshChildren;        // ワーカーごと：1回の展開で作った子（評価前）
+    std::vector<BoardBatch> batches;                     // ワーカーごと：形の特徴量をまとめて求める盤面
+    std::vector<BatchFeatures> batchFeatures;
+    TranspositionTable table;                            // 同じ状態に別の順番で着いた子を省く
+    TranspositionTable chanceTable;                      // 見えない先の値（盤面・Hold・袋の残りごと）
+    std::vector<std::vector<ChanceScratch>> chanceScratch;
+    FinessePlanner finesse;                              // 選んだ手の操作列（キーを押す回数が最少）
+
+    // node から1手進めた子を out に追加する（rootMoves を渡すのは最初の1手のときだけ）
+    void expand(const Node& node, const std::vector<PieceType>& sequence, bool holdAvailable,
+        int depth, int worker, std::vector<Node>& out, std::vector<RootMove>* rootMoves);
+
+    // 袋 bag から次のピースが出る局面の値（見えないピースを depth 個読んだ期待値）
+    double chanceValue(const BitBoard& board, int hold, std::uint8_t bag, int depth, int worker);
+};
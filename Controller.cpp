@@ -0,0 +1,158 @@
+#include "Controller.hpp"
+#include "Metrics.hpp"
+
+namespace {
+    bool grounded(const GameCore& core) {
+        return !core.getCurrentPiece().canMove(core.getBoard(), 0, 1);
+    }
+}
+
+// ==================== PlayerController クラス ====================
+PlayerController::PlayerController(const TimingConfig& timing)
+    : timing(timing), tickMs(1000.0 / timing.tickHz)
+{
+}
+
+void PlayerController::tick(GameCore& core, InputQueue& queue, std::int64_t tickEndUs) {
+    shiftPressedThisTick = false;
+
+    bool hardDropped = false;
+    {
+        PhaseTimer timer(Phase::HandleInput);
+
+        // --- この tick の終わりまでに起きた入力を順に適用する ---
+        InputEvent event;
+        while (queue.pop(tickEndUs, event))
+            hardDropped |= handleEvent(core, event, tickEndUs);
+        if (core.isGameOver()) return;
+
+        // --- 左右移動（DAS / ARR） ---
+        updateShift(core);
+    }
+
+    // --- 重力と固定猶予（ハードドロップした tick は新しいピースを落とさない） ---
+    if (hardDropped) return;
+    PhaseTimer timer(Phase::HandleFall);
+    applyGravity(core, heldSoftDrop);
+    updateLock(core);
+}
+
+// 押した瞬間に1回だけ操作し、左右・下は押している状態も覚える
+bool PlayerController::handleEvent(GameCore& core, const InputEvent& event, std::int64_t tickEndUs) {
+    switch (event.action) {
+    case Action::Left:
+    case Action::Right: {
+        int direction = event.action == Action::Left ? -1 : 1;
+        (direction < 0 ? heldLeft : heldRight) = event.pressed;
+        if (event.pressed) {
+            // 押した時刻から DAS を数え始める
+            shiftDirection = direction;
+            dasTimer = (tickEndUs - event.timeUs) / 1000.0;
+            arrTimer = 0.0;
+            shiftPressedThisTick = true;
+            applyAction(core, event.action);
+        }
+        else if (shiftDirection == direction) {
+            // 離したら、まだ押している逆方向に切り替える（DAS は最初から）
+            shiftDirection = heldLeft ? -1 : heldRight ? 1 : 0;
+            dasTimer = arrTimer = 0.0;
+            shiftPressedThisTick = true;
+        }
+        return false;
+    }
+    case Action::SoftDrop:
+        heldSoftDrop = event.pressed;
+        if (event.pressed) applyAction(core, Action::SoftDrop);   // 押した瞬間に1段
+        return false;
+    case Action::HardDrop:
+        if (!event.pressed) return false;
+        applyAction(core, Action::HardDrop);
+        return true;
+    case Action::RotateLeft:
+    case Action::RotateRight:
+    case Action::Hold:
+    case Action::Up:
+    case Action::DasLeft:     // ボットの操作列用：押し続けた結果を1回で適用する
+    case Action::DasRight:
+    case Action::SonicDrop:
+        if (event.pressed) applyAction(core, event.action);
+        return false;
+    default:
+        return false;
+    }
+}
+
+// 操作を1つ GameCore に渡し、結果に応じて固定猶予やピースの状態を更新する
+void PlayerController::applyAction(GameCore& core, Action action) {
+    if (core.isGameOver()) return;
+    StepResult result = core.step(action);
+    if (result.locked || (action == Action::Hold && result.moved)) resetPiece();
+    else if (result.moved) onMoved(core);
+}
+
+void PlayerController::updateShift(GameCore& core) {
+    if (shiftDirection == 0) return;
+
+    Action action = shiftDirection < 0 ? Action::Left : Action::Right;
+    if (!shiftPressedThisTick) dasTimer += tickMs;
+    if (dasTimer < timing.dasMs) return;
+
+    if (timing.arrMs <= 0.0) {
+        // ARR 0 は壁（ブロック）まで一気に動かす
+        while (core.getCurrentPiece().canMove(core.getBoard(), shiftDirection, 0)) applyAction(core, action);
+        return;
+    }
+    arrTimer += tickMs;
+    while (arrTimer >= timing.arrMs) {
+        arrTimer -= timing.arrMs;
+        if (!core.getCurrentPiece().canMove(core.getBoard(), shiftDirection, 0)) {
+            arrTimer = 0.0;
+            break;
+        }
+        applyAction(core, action);
+    }
+}
+
+// 重力（接地していれば落とさず、固定は updateLock に任せる）
+void PlayerController::applyGravity(GameCore& core, bool softDrop) {
+    gravityProgress += tickMs / timing.gravityMs * (softDrop ? timing.softDropFactor : 1.0);
+    while (gravityProgress >= 1.0) {
+        if (grounded(core)) {
+            gravityProgress = 0.0;
+            break;
+        }
+        gravityProgress -= 1.0;
+        applyAction(core, Action::SoftDrop);
+    }
+}
+
+// 接地している間だけ猶予を数え、使い切ったら固定する
+void PlayerController::updateLock(GameCore& core) {
+    if (core.isGameOver()) return;
+    if (!grounded(core)) {
+        lockTimer = 0.0;
+        return;
+    }
+    lockTimer += tickMs;
+    if (lockTimer >= timing.lockDelayMs) applyAction(core, Action::Gravity); // 接地中の Gravity は固定になる
+}
+
+// 移動・回転が成功したとき：より下に着いたら回数を戻し、接地中なら猶予を最初からにする
+void PlayerController::onMoved(const GameCore& core) {
+    int y = core.getCurrentPiece().y;
+    if (y > lowestY) {
+        lowestY = y;
+        lockResets = 0;
+    }
+    if (lockTimer > 0.0 && lockResets < timing.maxLockResets) {
+        lockTimer = 0.0;
+        ++lockResets;
+    }
+}
+
+void PlayerController::resetPiece() {
+    gravityProgress = 0.0;
+    lockTimer = 0.0;
+    lockResets = 0;
+    lowestY = -1;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "GameCore.hpp"
+#include "InputQueue.hpp"
+#include <cstdint>
+
+// PlayerController について
+// 人が操作するときの時間まわりの規則（DAS / ARR / ソフトドロップ / 重力 / 固定猶予）を、
+// 一定間隔の tick 単位で GameCore に適用するクラス
+// 時計や SFML には依存せず、tick() を呼んだ回数だけ決定的に進む（画面は Game 側が tick とは別に描く）
+// 入力は InputQueue から、その tick の終わりまでに起きた押した・離したを順に取り出して適用する
+//
+//   DAS  (Delayed Auto Shift) : 左右キーを押し続けたとき、連続移動が始まるまでの時間
+//   ARR  (Auto Repeat Rate)   : 連続移動が始まったあと、1マス動く間隔（0 なら壁まで一気に動く）
+//   重力                      : gravityMs ごとに1段落ちる。ソフトドロップ中は softDropFactor 倍の速さ
+//   固定猶予 (lock delay)      : 接地してから lockDelayMs たつと固定する。接地中に動かす・回すと
+//                               猶予が最初からになる（ただし同じ高さでは maxLockResets 回まで）
+
+// ==== 時間の設定（ミリ秒） ====
+struct TimingConfig {
+    int tickHz = 60;              // 1秒あたりの tick 数
+    double dasMs = 133.0;
+    double arrMs = 10.0;
+    double softDropFactor = 20.0;
+    double gravityMs = 1000.0;
+    double lockDelayMs = 500.0;
+    int maxLockResets = 15;
+};
+
+class PlayerController {
+public:
+    explicit PlayerController(const TimingConfig& timing = TimingConfig());
+
+    // 1 tick 進める（queue から時刻が tickEndUs 以下の入力をすべて取り出して適用する）
+    // 押した瞬間に1回動かし、左右は押した時刻から DAS を数えるので、tick の途中の入力も遅れない
+    void tick(GameCore& core, InputQueue& queue, std::int64_t tickEndUs);
+
+    const TimingConfig& getTiming() const { return timing; }
+
+private:
+    TimingConfig timing;
+    double tickMs;
+
+    // 押されているキー
+    bool heldLeft = false, heldRight = false, heldSoftDrop = false;
+
+    // 左右移動（後から押した方向を優先する）
+    int shiftDirection = 0;       // -1 = 左, 1 = 右, 0 = なし
+    double dasTimer = 0.0;        // 押してからの時間（この tick の終わりまで）
+    double arrTimer = 0.0;
+    bool shiftPressedThisTick = false;
+
+    double gravityProgress = 0.0; // 1.0 たまるごとに1段落とす
+    double lockTimer = 0.0;       // 接地してからの時間
+    int lockResets = 0;           // 同じ高さで猶予を戻した回数
+    int lowestY = -1;             // このピースが到達した一番下の y
+
+    // 1つの入力を適用する（hardDrop が押されたら true）
+    bool handleEvent(GameCore& core, const InputEvent& event, std::int64_t tickEndUs);
+    void updateShift(GameCore& core);
+    void applyGravity(GameCore& core, bool softDrop);
+    void updateLock(GameCore& core);
+    void onMoved(const GameCore& core);          // 移動・回転が成功したときの固定猶予の処理
+    void applyAction(GameCore& core, Action action);
+    void resetPiece();                           // 新しいピースが出たときの状態の初期化
+};
@@ -0,0 +1,245 @@
+#include "Dataset.hpp"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#include <io.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+    const std::uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+    struct Header {
+        char magic[4];
+        std::uint32_t version;
+        std::uint32_t recordSize;
+        std::uint32_t byteOrder;
+        std::uint8_t reserved[48];
+    };
+    static_assert(sizeof(Header) == DatasetWriter::HEADER_SIZE, "dataset header is 64 bytes");
+
+    Header makeHeader() {
+        Header h{};
+        std::memcpy(h.magic, "TDAT", 4);
+        h.version = DatasetWriter::VERSION;
+        h.recordSize = sizeof(DatasetRecord);
+        h.byteOrder = BYTE_ORDER_MARK;
+        return h;
+    }
+
+    // 開いているファイルの大きさ（2GB を超えても数えられるよう 64bit で取る。失敗したら -1）
+    std::int64_t fileSize(std::FILE* file) {
+#ifdef _WIN32
+        struct _stat64 st;
+        if (_fstat64(_fileno(file), &st) != 0) return -1;
+#else
+        struct stat st;
+        if (fstat(fileno(file), &st) != 0) return -1;
+#endif
+        return static_cast<std::int64_t>(st.st_size);
+    }
+
+    bool validHeader(const void* data) {
+        Header h;
+        std::memcpy(&h, data, sizeof(h));
+        return std::memcmp(h.magic, "TDAT", 4) == 0 && h.version == DatasetWriter::VERSION
+            && h.recordSize == sizeof(DatasetRecord) && h.byteOrder == BYTE_ORDER_MARK;
+    }
+
+}
+
+// core の今の局面と選んだ手からレコードを作る
+DatasetRecord makeDatasetRecord(const GameCore& core, bool useHold, const Placement& placement) {
+    DatasetRecord r{};
+    const Board& board = core.getBoard();
+    std::copy(board.rows.begin(), board.rows.end(), r.rows);
+    r.current = static_cast<std::int8_t>(core.getCurrentPiece().type);
+    r.hold = core.getHoldPiece() ? static_cast<std::int8_t>(core.getHoldPiece()->type) : -1;
+    r.holdUsed = core.getGameState().holdUsed ? 1 : 0;
+    r.useHold = useHold ? 1 : 0;
+    const auto& next = core.getNextQueue();
+    for (int i = 0; i < GameCore::NEXT_COUNT; ++i)
+        r.queue[i] = i < static_cast<int>(next.size()) ? static_cast<std::int8_t>(next[i]) : -1;
+    r.rotation = static_cast<std::uint8_t>(placement.rotation);
+    r.x = static_cast<std::int8_t>(placement.x);
+    r.y = static_cast<std::int8_t>(placement.y);
+    return r;
+}
+
+// 後ろから足していき、各手から局の終わりまでの数を埋める
+void finishDatasetRecords(std::vector<DatasetRecord>& records, bool toppedOut) {
+    std::uint32_t pieces = 0, lines = 0;
+    for (auto it = records.rbegin(); it != records.rend(); ++it) {
+        ++pieces;
+        lines += it->linesCleared;
+        it->piecesToEnd = pieces;
+        it->linesToEnd = lines;
+        it->toppedOut = toppedOut ? 1 : 0;
+    }
+}
+
+// ==================== DatasetWriter クラス ====================
+bool DatasetWriter::open(const std::string& path, bool append, std::size_t bufferRecords) {
+    close();
+    failed = false;
+    written = 0;
+    capacity = std::max<std::size_t>(bufferRecords, 1);
+    buffer.clear();
+    buffer.reserve(capacity);
+
+    // 既存のファイルに足す場合は、ヘッダと大きさを確かめる
+    if (append) {
+        if (std::FILE* existing = std::fopen(path.c_str(), "rb")) {
+            Header h;
+            bool ok = std::fread(&h, sizeof(h), 1, existing) == 1 && validHeader(&h);
+            std::int64_t size = fileSize(existing);
+            bool empty = !ok && std::ferror(existing) == 0 && size == 0;
+            std::fclose(existing);
+            if (ok) {
+                if (size < static_cast<std::int64_t>(HEADER_SIZE)) return false;
+                std::uint64_t body = static_cast<std::uint64_t>(size) - HEADER_SIZE;
+                if (body % sizeof(DatasetRecord) != 0) return false;
+                written = body / sizeof(DatasetRecord);
+                file = std::fopen(path.c_str(), "ab");
+            }
+            else if (!empty) {
+                return false;
+            }
+        }
+    }
+
+    // 新しく作る
+    if (!file) {
+        written = 0;
+        file = std::fopen(path.c_str(), "wb");
+        if (!file) return false;
+        Header h = makeHeader();
+        if (std::fwrite(&h, sizeof(h), 1, file) != 1) {
+            std::fclose(file);
+            file = nullptr;
+            return false;
+        }
+    }
+    if (!file) return false;
+
+    // こちらで大きな塊にまとめて書くので、stdio の側ではためない
+    std::setvbuf(file, nullptr, _IONBF, 0);
+    return true;
+}
+
+void DatasetWriter::append(const DatasetRecord& record) {
+    buffer.push_back(record);
+    if (buffer.size() >= capacity) flush();
+}
+
+void DatasetWriter::append(const DatasetRecord* records, std::size_t count) {
+    while (count > 0) {
+        std::size_t n = std::min(count, capacity - buffer.size());
+        buffer.insert(buffer.end(), records, records + n);
+        records += n;
+        count -= n;
+        if (buffer.size() >= capacity) flush();
+    }
+}
+
+bool DatasetWriter::flush() {
+    if (!file) return false;
+    if (!buffer.empty()) {
+        std::size_t n = std::fwrite(buffer.data(), sizeof(DatasetRecord), buffer.size(), file);
+        written += n;
+        if (n != buffer.size()) failed = true;
+        buffer.clear();
+    }
+    return !failed;
+}
+
+bool DatasetWriter::close() {
+    if (!file) return !failed;
+    flush();
+    if (std::fclose(file) != 0) failed = true;
+    file = nullptr;
+    return !failed;
+}
+
+// ==================== DatasetReader クラス ====================
+bool DatasetReader::open(const std::string& path, Access access) {
+    close();
+
+#ifdef _WIN32
+    HANDLE f = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        access == Access::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (f == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(f, &size) || static_cast<std::uint64_t>(size.QuadPart) < DatasetWriter::HEADER_SIZE) {
+        CloseHandle(f);
+        return false;
+    }
+    HANDLE m = CreateFileMappingA(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m) {
+        CloseHandle(f);
+        return false;
+    }
+    void* data = MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(m);
+        CloseHandle(f);
+        return false;
+    }
+    fileHandle = f;
+    mappingHandle = m;
+    view = data;
+    viewSize = static_cast<std::size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<std::uint64_t>(st.st_size) < DatasetWriter::HEADER_SIZE) {
+        ::close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // 対応づけたあとはファイルを閉じてもよい
+    if (data == MAP_FAILED) return false;
+    madvise(data, static_cast<std::size_t>(st.st_size), access == Access::Sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+    view = data;
+    viewSize = static_cast<std::size_t>(st.st_size);
+#endif
+
+    if (!validHeader(view)) {
+        close();
+        return false;
+    }
+    records = reinterpret_cast<const DatasetRecord*>(static_cast<const char*>(view) + DatasetWriter::HEADER_SIZE);
+    count = (viewSize - DatasetWriter::HEADER_SIZE) / sizeof(DatasetRecord);
+    return true;
+}
+
+void DatasetReader::close() {
+#ifdef _WIN32
+    if (view) UnmapViewOfFile(view);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    fileHandle = mappingHandle = nullptr;
+#else
+    if (view) munmap(view, viewSize);
+#endif
+    view = nullptr;
+    viewSize = 0;
+    records = nullptr;
+    count = 0;
+}
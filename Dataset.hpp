@@ -0,0 +1,113 @@
+#pragma once
+#include "GameCore.hpp"
+#include "MoveGen.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// 学習データセットの形式について
+// 1局面を 64 バイト固定のレコード（DatasetRecord）にして、ファイルの後ろへ順に追記していく
+// レコードの長さが決まっているので、読む側はファイルを mmap して i 番目を配列のように直接引ける（解析は不要）
+//
+// ファイルの中身:
+//   ヘッダ 64 バイト: "TDAT" / version(u32) / recordSize(u32) / byteOrder(u32 = 0x01020304) / 残りは 0
+//   レコード × 件数（件数はファイルの大きさから求める。途中で止まった書きかけの末尾は読まない）
+// 数値は書いた計算機のバイト順のまま（byteOrder で確かめ、違えば読まない）
+
+// ==== 1局面（置く前の状態・選んだ手・その後の結果） ====
+struct DatasetRecord {
+    std::uint16_t rows[Board::HEIGHT];   // 盤面の占有ビット（y = 0 が一番上）
+    std::int8_t current;                 // 現在のピース（PieceType）
+    std::int8_t hold;                    // Hold 中の種類（-1 なら空）
+    std::uint8_t holdUsed;               // このターンで Hold を使ったか
+    std::uint8_t useHold;                // 選んだ手：先に Hold したか
+    std::int8_t queue[GameCore::NEXT_COUNT]; // Next
+    std::uint8_t rotation;               // 選んだ手：置いた回転状態
+    std::int8_t x, y;                    // 選んだ手：置いた位置（Placement と同じ）
+    std::uint8_t linesCleared;           // この手で消したライン数
+    std::uint8_t toppedOut;              // この局が積み上がって終わったか
+    std::uint16_t reserved;
+    std::uint32_t piecesToEnd;           // この手を含めて、局の終わりまでに置いたピースの数
+    std::uint32_t linesToEnd;            // この手を含めて、局の終わりまでに消したライン数
+};
+
+static_assert(sizeof(DatasetRecord) == 64, "dataset records are 64 bytes");
+static_assert(std::is_trivially_copyable<DatasetRecord>::value, "dataset records are read in place");
+
+// core の今の局面と選んだ手からレコードを作る（結果の欄は 0、局の終わりに埋める）
+DatasetRecord makeDatasetRecord(const GameCore& core, bool useHold, const Placement& placement);
+
+// 1局ぶんのレコードの結果の欄を、局の終わりの状態から埋める
+void finishDatasetRecords(std::vector<DatasetRecord>& records, bool toppedOut);
+
+// ==== 追記（バッファにためて大きな塊で順に書く） ====
+class DatasetWriter {
+public:
+    static const std::uint32_t VERSION = 1;
+    static const std::size_t HEADER_SIZE = 64;
+
+    DatasetWriter() {}
+    ~DatasetWriter() { close(); }
+    DatasetWriter(const DatasetWriter&) = delete;
+    DatasetWriter& operator=(const DatasetWriter&) = delete;
+
+    // path を開く。append なら既存のファイルの後ろに足し（ヘッダが合わない・末尾が途中で切れていれば失敗）、
+    // そうでなければ作り直す
+    bool open(const std::string& path, bool append = true, std::size_t bufferRecords = 4096);
+
+    void append(const DatasetRecord& record);
+    void append(const DatasetRecord* records, std::size_t count);
+
+    bool flush();   // バッファの中身を書き出す（書けなければ false）
+    bool close();
+
+    bool isOpen() const { return file != nullptr; }
+    std::uint64_t recordCount() const { return written + buffer.size(); }
+
+private:
+    std::FILE* file = nullptr;
+    std::vector<DatasetRecord> buffer;
+    std::size_t capacity = 0;
+    std::uint64_t written = 0;   // ファイルにあるレコードの数
+    bool failed = false;
+};
+
+// ==== 読み込み（ファイルを mmap してそのまま引く） ====
+class DatasetReader {
+public:
+    // 読み方のヒント（OS の先読みに使う）
+    enum class Access { Sequential, Random };
+
+    DatasetReader() {}
+    ~DatasetReader() { close(); }
+    DatasetReader(const DatasetReader&) = delete;
+    DatasetReader& operator=(const DatasetReader&) = delete;
+
+    bool open(const std::string& path, Access access = Access::Sequential);
+    void close();
+
+    std::size_t size() const { return count; }
+    const DatasetRecord& operator[](std::size_t i) const { return records[i]; }
+    const DatasetRecord* begin() const { return records; }
+    const DatasetRecord* end() const { return records + count; }
+
+    // 一様に1件選ぶ（空なら呼ばないこと）
+    template <typename Rng>
+    const DatasetRecord& sample(Rng& rng) const {
+        return records[std::uniform_int_distribution<std::size_t>(0, count - 1)(rng)];
+    }
+
+private:
+    const DatasetRecord* records = nullptr;
+    std::size_t count = 0;
+    void* view = nullptr;          // 対応づけたファイル全体
+    std::size_t viewSize = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
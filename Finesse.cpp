@@ -0,0 +1,208 @@
+#include "Finesse.hpp"
+#include <algorithm>
+
+// ==== 空の盤面の最短操作列の表 ====
+// paths[種類][回転状態][x + MARGIN]
+struct FinesseTable {
+    std::array<std::array<std::array<InputSequence, FinessePlanner::SPAN_X>, 4>, 7> paths;
+
+    FinesseTable() {
+        FinessePlanner planner;
+        BitBoard empty;
+        for (int t = 0; t < 7; t++) {
+            PieceType type = static_cast<PieceType>(t);
+            planner.search(empty, type, false, -1);
+
+            // 埋まる列が同じなら、回転状態が違っても（S/Z/I の表裏、O の回転）同じ置き方として一番短いものを使う
+            std::array<std::array<InputSequence, FinessePlanner::SPAN_X>, 4> best;
+            for (int s = 0; s < FinessePlanner::STATE_COUNT; s++) {
+                if (planner.visited[s] != planner.stamp) continue;
+                int x = s % FinessePlanner::SPAN_X - FinessePlanner::MARGIN;
+                int r = s / (FinessePlanner::SPAN_X * FinessePlanner::SPAN_Y);
+                int canon = canonicalRotation(type, static_cast<Rotation>(r));
+                int left = x + SRS_MASKS[t][r].minX + FinessePlanner::MARGIN;
+                std::vector<Action> path = planner.pathFrom(s);
+                if (static_cast<int>(path.size()) > InputSequence::MAX_KEYS) continue;
+                InputSequence& entry = best[canon][left];
+                if (entry.count >= 0 && entry.count <= static_cast<int>(path.size())) continue;
+                entry.count = static_cast<int>(path.size());
+                std::copy(path.begin(), path.end(), entry.keys.begin());
+            }
+            for (int r = 0; r < 4; r++) {
+                int canon = canonicalRotation(type, static_cast<Rotation>(r));
+                for (int x = -FinessePlanner::MARGIN; x + FinessePlanner::MARGIN < FinessePlanner::SPAN_X; x++) {
+                    int left = x + SRS_MASKS[t][r].minX + FinessePlanner::MARGIN;
+                    if (left >= 0 && left < FinessePlanner::SPAN_X) paths[t][r][x + FinessePlanner::MARGIN] = best[canon][left];
+                }
+            }
+        }
+    }
+};
+
+namespace {
+
+    const FinesseTable& finesseTable() {
+        static const FinesseTable table;
+        return table;
+    }
+
+    // 回転（Piece::rotate と同じ順にキックを試す）。回れたら x, y, r を書き換えて true
+    bool rotate(const BitBoard& board, int t, int& x, int& y, int& r, bool left) {
+        int nr = (r + (left ? 1 : 3)) % 4;
+        const KickList& kicks = SRS_KICKS[t][r][left ? 0 : 1];
+        for (int i = 0; i < kicks.count; i++) {
+            int nx = x + kicks.delta[i].x, ny = y + kicks.delta[i].y;
+            if (!board.overlaps(SRS_MASKS[t][nr], nx, ny)) {
+                x = nx;
+                y = ny;
+                r = nr;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // キーを1回押したあとの状態（動けなければ false）。GameCore::step と同じ規則
+    bool applyKey(const BitBoard& board, int t, Action key, int& x, int& y, int& r) {
+        const PieceMask& mask = SRS_MASKS[t][r];
+        switch (key) {
+        case Action::Left:
+        case Action::Right: {
+            int dx = key == Action::Left ? -1 : 1;
+            if (board.overlaps(mask, x + dx, y)) return false;
+            x += dx;
+            return true;
+        }
+        case Action::DasLeft:
+        case Action::DasRight: {
+            int dx = key == Action::DasLeft ? -1 : 1;
+            if (board.overlaps(mask, x + dx, y)) return false;
+            while (!board.overlaps(mask, x + dx, y)) x += dx;
+            return true;
+        }
+        case Action::SoftDrop:
+            if (board.overlaps(mask, x, y + 1)) return false;
+            ++y;
+            return true;
+        case Action::SonicDrop: {
+            int distance = board.dropDistance(mask, x, y);
+            y += distance;
+            return distance > 0;
+        }
+        case Action::RotateLeft:
+        case Action::RotateRight:
+            return rotate(board, t, x, y, r, key == Action::RotateLeft);
+        default:
+            return false;
+        }
+    }
+
+    // ハードドロップで埋まるマスを表す番号（左上の位置と、同じ形の中で最小の回転状態）
+    int landingKey(const BitBoard& board, int t, int x, int y, int r) {
+        const PieceMask& mask = SRS_MASKS[t][r];
+        int landY = y + board.dropDistance(mask, x, y);
+        int canon = canonicalRotation(static_cast<PieceType>(t), static_cast<Rotation>(r));
+        return (canon * FinessePlanner::SPAN_Y + (landY + mask.minY + FinessePlanner::MARGIN)) * FinessePlanner::SPAN_X
+            + (x + mask.minX + FinessePlanner::MARGIN);
+    }
+
+    // 探索で試すキー（同じ回数なら先に並んでいるものを使う）
+    const std::array<Action, 8> KEYS = {
+        Action::DasLeft, Action::DasRight, Action::Left, Action::Right,
+        Action::RotateRight, Action::RotateLeft, Action::SonicDrop, Action::SoftDrop
+    };
+
+}
+
+// ==================== FinessePlanner クラス ====================
+FinessePlanner::FinessePlanner() {}
+
+const InputSequence& FinessePlanner::emptyBoardPath(PieceType type, Rotation rotation, int x) {
+    static const InputSequence none;
+    if (x + MARGIN < 0 || x + MARGIN >= SPAN_X) return none;
+    return finesseTable().paths[static_cast<int>(type)][static_cast<int>(rotation)][x + MARGIN];
+}
+
+// 出現位置からキー操作1回ずつの幅優先探索
+int FinessePlanner::search(const BitBoard& board, PieceType type, bool drops, int target, int maxKeys) {
+    if (++stamp == 0) {
+        visited.fill(0);
+        stamp = 1;
+    }
+
+    const int t = static_cast<int>(type);
+    Piece spawn(type);
+    if (board.overlaps(SRS_MASKS[t][0], spawn.x, spawn.y)) return -1;
+
+    int head = 0, tail = 0;
+    int start = index(spawn.x, spawn.y, 0);
+    visited[start] = stamp;
+    parent[start] = -1;
+    keyCount[start] = 0;
+    queue[tail++] = static_cast<std::int16_t>(start);
+
+    while (head < tail) {
+        int s = queue[head++];
+        int x = s % SPAN_X - MARGIN;
+        int y = (s / SPAN_X) % SPAN_Y - MARGIN;
+        int r = s / (SPAN_X * SPAN_Y);
+        if (target >= 0 && landingKey(board, t, x, y, r) == target) return s;
+        if (keyCount[s] >= maxKeys) continue;
+
+        for (Action key : KEYS) {
+            if (!drops && (key == Action::SoftDrop || key == Action::SonicDrop)) continue;
+            int nx = x, ny = y, nr = r;
+            if (!applyKey(board, t, key, nx, ny, nr)) continue;
+            int n = index(nx, ny, nr);
+            if (visited[n] == stamp) continue;
+            visited[n] = stamp;
+            parent[n] = static_cast<std::int16_t>(s);
+            via[n] = key;
+            keyCount[n] = static_cast<std::uint8_t>(std::min(keyCount[s] + 1, 255));
+            queue[tail++] = static_cast<std::int16_t>(n);
+        }
+    }
+    return -1;
+}
+
+// 直前の探索の親をたどって操作列を復元する（HardDrop は含まない）
+std::vector<Action> FinessePlanner::pathFrom(int state) const {
+    std::vector<Action> path;
+    for (int s = state; parent[s] >= 0; s = parent[s]) path.push_back(via[s]);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+// placement に置く最短の操作列
+std::vector<Action> FinessePlanner::plan(const BitBoard& board, const Placement& placement) {
+    const int t = static_cast<int>(placement.type);
+    int target = landingKey(board, t, placement.x, placement.y, static_cast<int>(placement.rotation));
+
+    // --- 空の盤面の表の操作列を、この盤面でなぞって確かめる ---
+    const InputSequence& known = emptyBoardPath(placement.type, placement.rotation, placement.x);
+    Piece spawn(placement.type);
+    if (known.count >= 0 && !board.overlaps(SRS_MASKS[t][0], spawn.x, spawn.y)) {
+        int x = spawn.x, y = spawn.y, r = 0;
+        bool ok = true;
+        for (int i = 0; i < known.count && ok; i++) ok = applyKey(board, t, known.keys[i], x, y, r);
+        if (ok && landingKey(board, t, x, y, r) == target) {
+            // 積みに当てて止めるなど、盤面の上でだけ使えるもっと短い列がないか確かめる
+            int shorter = known.count > 0 ? search(board, placement.type, true, target, known.count - 1) : -1;
+            if (shorter >= 0) {
+                std::vector<Action> path = pathFrom(shorter);
+                path.push_back(Action::HardDrop);
+                return path;
+            }
+            std::vector<Action> path(known.keys.begin(), known.keys.begin() + known.count);
+            path.push_back(Action::HardDrop);
+            return path;
+        }
+    }
+
+    // --- 差し込みやキックが要る配置は、この盤面で探す ---
+    int goal = search(board, placement.type, true, target);
+    if (goal < 0) return {};
+    std::vector<Action> path = pathFrom(goal);
+    path.push_back(Action::HardDrop);
+    return path;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "Board.hpp"
+#include "GameCore.hpp"
+#include "MoveGen.hpp"
+#include "Piece.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// 最短入力（フィネス）について
+// キー操作1回（左右のタップ・左右の長押し DasLeft/DasRight・回転・ソフトドロップ1段・下の長押し SonicDrop・
+// ハードドロップ）をどれも1回と数え、置きたい位置までの回数が一番少ない操作列を求める
+//   空の盤面の表: 種類・回転状態・列ごとに、出現位置から回して左右に動かすだけの最短の操作列を最初に一度だけ求めておく
+//                 上が空いている配置なら、表の操作列を盤面の上でなぞって確かめ、
+//                 それより短い列（積みに当てて止める長押しなど）がないかを表の回数未満に限って探すだけで済む
+//   盤面での探索: 表の操作列では届かない配置（差し込み・キックが必要なもの、積みが出現位置の近くまであるとき）は、
+//                 その盤面でキー操作1回を1辺とした幅優先探索で求める
+// MoveGenerator::pathTo は1段ずつのソフトドロップも1手と数える経路なので、キーを押す回数はこちらのほうが少ない
+
+// ==== 決まった長さまでの操作列（空の盤面の表の1項目、HardDrop は含まない） ====
+struct InputSequence {
+    static const int MAX_KEYS = 8;
+    std::array<Action, MAX_KEYS> keys{};
+    int count = -1;               // -1 ならその位置には置けない
+};
+
+class FinessePlanner {
+public:
+    static const int MARGIN = MoveGenerator::MARGIN;
+    static const int SPAN_X = MoveGenerator::SPAN_X;
+    static const int SPAN_Y = MoveGenerator::SPAN_Y;
+    static const int STATE_COUNT = MoveGenerator::STATE_COUNT;
+
+    FinessePlanner();
+
+    // 空の盤面で (rotation, x) の位置にハードドロップする前までの最短の操作列
+    static const InputSequence& emptyBoardPath(PieceType type, Rotation rotation, int x);
+
+    // board で placement に置く、キーを押す回数が一番少ない操作列（最後は HardDrop）。置けなければ空
+    std::vector<Action> plan(const BitBoard& board, const Placement& placement);
+
+private:
+    static int index(int x, int y, int rotation) {
+        return (rotation * SPAN_Y + (y + MARGIN)) * SPAN_X + (x + MARGIN);
+    }
+
+    // 出現位置から幅優先探索し、ハードドロップで埋まるマスが target（landingKey）になる状態を返す
+    // target が -1 なら最後まで探索する。drops が false なら下へ動く操作は使わない（空の盤面の表用）
+    // maxKeys 回までの操作で届く状態だけを調べる
+    int search(const BitBoard& board, PieceType type, bool drops, int target, int maxKeys = STATE_COUNT);
+    std::vector<Action> pathFrom(int state) const;
+
+    // 探索ごとに stamp を進め、配列を毎回クリアしなくて済むようにする
+    std::uint32_t stamp = 0;
+    std::array<std::uint32_t, STATE_COUNT> visited{};
+    std::array<std::int16_t, STATE_COUNT> parent{};
+    std::array<Action, STATE_COUNT> via{};
+    std::array<std::uint8_t, STATE_COUNT> keyCount{};  // 出現位置からの操作の回数
+    std::array<std::int16_t, STATE_COUNT> queue{};
+
+    friend struct FinesseTable;
+};
@@ -0,0 +1,100 @@
+#include "Game.hpp"
+#include "Metrics.hpp"
+#include <cstdlib>
+
+// ==================== Game クラス ==================== 
+// コンストラクタ：ウィンドウ生成（ピースとNextキューは GameCore が準備する）
+Game::Game(const TimingConfig& timing)
+    : window(sf::VideoMode(Board::WIDTH * 40 + 200, Board::HEIGHT * 40), "Tetris"), controller(timing)
+{
+    // 押しっぱなしの連続入力は DAS / ARR で扱うので、OS のキーリピートは使わない
+    window.setKeyRepeatEnabled(false);
+}
+
+// メインループ
+// ゲームは 1/tickHz 秒ごとの tick で進め、描画は tick とは別にループ1回につき1度だけ行う
+// 次の tick までは眠るので、1局で1コアを使い切ることはない
+// 環境変数 TETRIS_METRICS_FILE があれば、終了時にカウンタと各段階の所要時間をそのファイルに書く
+void Game::run() {
+    const sf::Time tick = sf::seconds(1.f / controller.getTiming().tickHz);
+    const std::int64_t tickUs = tick.asMicroseconds();
+    sf::Clock clock;
+    sf::Time lag = sf::Time::Zero;
+    inputClock.restart();
+    simulatedUs = 0;
+
+    while (window.isOpen()) {
+        {
+            PhaseTimer timer(Phase::HandleEvents);
+            handleEvents();
+        }
+
+        // 経過した時間の分だけ tick を進める（大きく遅れたら追いつくのをあきらめる）
+        lag += clock.restart();
+        int steps = 0;
+        while (lag >= tick && steps < MAX_CATCH_UP) {
+            simulatedUs += tickUs;
+            controller.tick(core, inputs, simulatedUs);
+            lag -= tick;
+            ++steps;
+        }
+        if (steps == MAX_CATCH_UP) {
+            lag = sf::Time::Zero;
+            simulatedUs = inputClock.getElapsedTime().asMicroseconds();
+        }
+
+        {
+            PhaseTimer timer(Phase::Render);
+            render();
+        }
+
+        // 次の tick まで眠る
+        sf::Time wait = tick - lag - clock.getElapsedTime();
+        if (wait > sf::Time::Zero) sf::sleep(wait);
+    }
+
+    if (const char* path = std::getenv("TETRIS_METRICS_FILE")) Metrics::instance().dump(path);
+}
+
+// キーを Action に対応させる（対応しないキーなら Action::None）
+static Action keyToAction(sf::Keyboard::Key key) {
+    switch (key) {
+    case sf::Keyboard::Left:  return Action::Left;
+    case sf::Keyboard::Right: return Action::Right;
+    case sf::Keyboard::Down:  return Action::SoftDrop;
+    //SFMLの関係上逆にする必要がある
+    case sf::Keyboard::Z:     return Action::RotateLeft;
+    case sf::Keyboard::X:     return Action::RotateRight;
+    case sf::Keyboard::Up:    return Action::Up;
+    case sf::Keyboard::Space: return Action::HardDrop;
+    case sf::Keyboard::C:     return Action::Hold;
+    default:                  return Action::None;
+    }
+}
+
+// イベント処理（ウィンドウを閉じる、キーの押した・離したを時刻つきで積む）
+void Game::handleEvents() {
+    sf::Event event;
+    while (window.pollEvent(event)) {
+        if (event.type == sf::Event::Closed) {
+            window.close();
+        }
+        else if (event.type == sf::Event::KeyPressed || event.type == sf::Event::KeyReleased) {
+            Action action = keyToAction(event.key.code);
+            if (action != Action::None)
+                inputs.push(inputClock.getElapsedTime().asMicroseconds(), action, event.type == sf::Event::KeyPressed);
+        }
+    }
+}
+
+// 描画処理
+void Game::render() {
+    window.clear();
+    renderer.draw(window, core);          // 盤面・現在のピース・Next・Hold（draw は2回）
+    window.display();
+}
+
+// 現在の状態を返却する（GameCore に委譲）
+GameState Game::getGameState() const {
+    return core.getGameState();
+}
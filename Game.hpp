@@ -0,0 +1,32 @@
+#pragma once
+#include "Controller.hpp"
+#include "GameCore.hpp"
+#include "InputQueue.hpp"
+#include "Renderer.hpp"
+#include <SFML/Graphics.hpp>
+
+// ==== ゲーム全体を管理するクラス（SFMLの画面・キーボード・時計を担当） ====
+// ゲームの規則や状態はすべて GameCore が持ち、ここでは入力を Action に変換して渡し、描画するだけ
+class Game {
+private:
+    sf::RenderWindow window;                 // ゲームウィンドウ
+    GameCore core;                           // ウィンドウを持たないゲーム本体
+    BoardRenderer renderer;                  // 盤面・ピース・Next・Hold をまとめて描く
+
+    PlayerController controller;             // DAS / ARR / 重力 / 固定猶予を tick 単位で適用する
+    InputQueue inputs;                       // キーを押した・離したの時刻つきの列
+    sf::Clock inputClock;                    // 入力の時刻を測る時計（ゲーム開始からの時間）
+    std::int64_t simulatedUs = 0;            // 進めた tick の終わりの時刻（inputClock と同じ基準）
+
+    static const int MAX_CATCH_UP = 5;       // 遅れたときに1ループで進める tick の上限
+
+    sf::Font font;                           // GUI用フォント（スコアやNext表示に利用）
+
+public:
+    explicit Game(const TimingConfig& timing = TimingConfig()); // コンストラクタ（ウィンドウ生成）
+    void run();                              // メインループ（固定間隔の tick と描画を回し、間は眠る）
+    GameState getGameState() const;          // 状態を取得する関数
+private:
+    void handleEvents();                     // イベント処理（閉じるボタン、キーの押した・離した）
+    void render();                           // 描画処理（盤面・ピース・UI表示）
+};
@@ -0,0 +1,241 @@
+#include "GameCore.hpp"
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include <algorithm>
+
+// ==================== GameCore クラス ====================
+// コンストラクタ：最初のピースを出し、Nextキューを準備
+GameCore::GameCore()
+    : currentPiece(draw())
+{
+    // Nextキューに最初の5つを補充
+    for (int i = 0; i < NEXT_COUNT; ++i) nextQueue.push_back(draw());
+}
+
+// シード指定：Bag の順番を固定する
+GameCore::GameCore(std::uint64_t seed, bool withColors)
+    : board(withColors), bag(seed), seed(seed), currentPiece(draw())
+{
+    for (int i = 0; i < NEXT_COUNT; ++i) nextQueue.push_back(draw());
+}
+
+// スナップショットから復元する
+// Bag を同じシードで作り直して bagDraws 個引き、最後の6個を現在のピースと Next に戻す
+GameCore::GameCore(const GameSnapshot& snapshot)
+    : bag(snapshot.seed), seed(snapshot.seed), currentPiece(PieceType::T)
+{
+    // 現在のピースと Next の分（NEXT_COUNT + 1 個）より少なくは引かない
+    // （既定値の GameSnapshot の bagDraws = 0 でも、drawn が空や Next が足りない状態にしない）
+    std::uint32_t draws = std::max<std::uint32_t>(snapshot.bagDraws, NEXT_COUNT + 1);
+    std::deque<PieceType> drawn;
+    while (bagDraws < draws) {
+        drawn.push_back(draw());
+        if (static_cast<int>(drawn.size()) > NEXT_COUNT + 1) drawn.pop_front();
+    }
+    currentPiece = Piece(drawn.front());
+    drawn.pop_front();
+    nextQueue = drawn;
+
+    // 盤面（色は残っていないので灰色で埋める）
+    board.rows = snapshot.rows;
+    board.rehash();
+    for (int y = 0; y < Board::HEIGHT; ++y)
+        for (int x = 0; x < Board::WIDTH; ++x)
+            if ((board.rows[y] >> x) & 1u) board.colors[y * Board::WIDTH + x] = sf::Color(128, 128, 128);
+
+    if (snapshot.hold >= 0 && snapshot.hold < 7) {
+        holdPiece = Piece(static_cast<PieceType>(snapshot.hold));
+        holdExists = true;
+    }
+    holdUsed = snapshot.holdUsed;
+    gameOver = !currentPiece.canMove(board, 0, 0);
+}
+
+// Bag から1つ引く
+PieceType GameCore::draw() {
+    ++bagDraws;
+    return bag.getNext();
+}
+
+// 操作を1つ適用する（同じ状態に同じ操作を与えれば必ず同じ結果になる）
+StepResult GameCore::step(Action action) {
+    StepResult result;
+    if (gameOver) {
+        result.gameOver = true;
+        return result;
+    }
+
+    switch (action) {
+    case Action::None:
+        break;
+
+    // --- 左右移動 ---
+    case Action::Left:
+        if ((result.moved = currentPiece.canMove(board, -1, 0))) currentPiece.move(-1, 0);
+        break;
+    case Action::Right:
+        if ((result.moved = currentPiece.canMove(board, 1, 0))) currentPiece.move(1, 0);
+        break;
+
+    // --- 壁（かブロック）まで左右移動 ---
+    case Action::DasLeft:
+    case Action::DasRight: {
+        int dx = action == Action::DasLeft ? -1 : 1;
+        while (currentPiece.canMove(board, dx, 0)) {
+            currentPiece.move(dx, 0);
+            result.moved = true;
+        }
+        break;
+    }
+
+    // --- 下移動 ---
+    case Action::SoftDrop:
+        if ((result.moved = currentPiece.canMove(board, 0, 1))) currentPiece.move(0, 1);
+        break;
+    case Action::SonicDrop: {
+        int distance = currentPiece.dropDistance(board);
+        currentPiece.move(0, distance);
+        result.moved = distance > 0;
+        break;
+    }
+
+    // --- 上移動（1段上げる） ---
+    case Action::Up:
+        if ((result.moved = currentPiece.canMove(board, 0, -1))) currentPiece.move(0, -1);
+        break;
+
+    // --- 回転 ---
+    case Action::RotateLeft:
+        result.moved = currentPiece.rotate(board, true);
+        break;
+    case Action::RotateRight:
+        result.moved = currentPiece.rotate(board, false);
+        break;
+
+    // --- ハードドロップ ---
+    case Action::HardDrop:
+        currentPiece.move(0, currentPiece.dropDistance(board));  // 一番下まで落とす
+        result.moved = true;
+        lockPiece(result);
+        break;
+
+    // --- Hold機能 ---
+    case Action::Hold:
+        result.moved = hold();
+        break;
+
+    // --- 自動落下 ---
+    case Action::Gravity:
+        if (currentPiece.canMove(board, 0, 1)) {
+            currentPiece.move(0, 1);
+            result.moved = true;
+        }
+        else {
+            // 動けない＝着地 → 盤面に固定
+            lockPiece(result);
+        }
+        break;
+    }
+
+    result.gameOver = gameOver;
+    return result;
+}
+
+// 現在のピースを指定の位置に直接置いて固定する
+StepResult GameCore::placeAt(Rotation rotation, int x, int y) {
+    StepResult result;
+    if (!gameOver) {
+        Piece target = currentPiece;
+        target.rotation = rotation;
+        target.blocks = target.getRotatedCells(static_cast<int>(rotation));
+        target.x = x;
+        target.y = y;
+        // 重ならず、かつ着地している位置だけを受け付ける
+        if (target.canMove(board, 0, 0) && !target.canMove(board, 0, 1)) {
+            currentPiece = target;
+            result.moved = true;
+            lockPiece(result);
+        }
+    }
+    result.gameOver = gameOver;
+    return result;
+}
+
+// スナップショット
+GameSnapshot GameCore::snapshot() const {
+    GameSnapshot s;
+    s.seed = seed;
+    s.bagDraws = bagDraws;
+    s.rows = board.rows;
+    s.hold = holdPiece ? static_cast<int>(holdPiece->type) : -1;
+    s.holdUsed = holdUsed;
+    return s;
+}
+
+// 現在のピースを固定してライン消去し、Nextの先頭を出す
+void GameCore::lockPiece(StepResult& result) {
+    currentPiece.place(board);                 // 盤面に固定
+    result.locked = true;
+    result.linesCleared = board.clearLines();  // ライン消去
+    Metrics::count(Counter::PiecesPlaced);
+    if (result.linesCleared > 0) Metrics::count(lineClearCounter(result.linesCleared));
+
+    // 次のピースをセット
+    PieceType next = nextQueue.front();
+    nextQueue.pop_front();
+    nextQueue.push_back(draw());
+    holdUsed = false; // ホールド使用可能に戻す
+    spawn(next);
+}
+
+// 指定の種類を初期位置(x=3,y=0)に出現させる。出現位置が埋まっていればゲーム終了
+void GameCore::spawn(PieceType type) {
+    currentPiece = Piece(type);
+    if (!currentPiece.canMove(board, 0, 0)) gameOver = true;
+}
+
+// Hold処理。まだこのターンでHoldを使っていない場合のみ入れ替える
+bool GameCore::hold() {
+    if (holdUsed) return false;
+
+    PieceType current = currentPiece.type;
+    if (!holdExists) {
+        // === 初回ホールド ===
+        // holdにピースが存在することを記録し、Nextキューの先頭を出す
+        holdExists = true;
+        PieceType next = nextQueue.front();
+        nextQueue.pop_front();
+        nextQueue.push_back(draw());
+        spawn(next);
+    }
+    else {
+        // === 2回目以降のHold ===
+        // hold中のピースを現在のピースとして生成し直す
+        spawn(holdPiece->type);
+    }
+    holdPiece = Piece(current);
+    LOG_DEBUG("game", "hold piece=%s current=%s", pieceTypeToString(holdPiece->type).c_str(),
+        pieceTypeToString(currentPiece.type).c_str());
+
+    // このターンではもうHoldを使えないようにフラグを立てる
+    holdUsed = true;
+    Metrics::count(Counter::Holds);
+    return true;
+}
+
+//現在のミノ、ネクスト、Holdの状態を返却する
+GameState GameCore::getGameState() const {
+    GameState state;
+    state.currentPiece = currentPiece.type;
+    state.holdExists = holdExists;
+    state.holdUsed = holdUsed;
+
+    // Nextキューの先頭から最大5個をコピー
+    int i = 0;
+    for (auto& p : nextQueue) {
+        if (i >= NEXT_COUNT) break;
+        state.nextPieces[i++] = p;
+    }
+
+    return state;
+}
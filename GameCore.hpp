@@ -0,0 +1,108 @@
+#pragma once
+#include "Board.hpp"
+#include "Piece.hpp"
+#include <array>
+#include <deque>
+#include <optional>
+
+// GameCore について
+// ウィンドウ・キーボード・時計に依存しない、ゲーム本体の状態と規則だけを持つクラス
+// 入力は Action で受け取り、step() を呼んだ分だけ決定的に進む
+// SFML の画面（Game）やボット、ヘッドレスのシミュレーションはすべてこれを操作する
+
+// ==== ゲームの状態を表す構造体 ====
+struct GameState {
+    PieceType currentPiece;                 // 現在操作中のミノ
+    std::array<PieceType, 5> nextPieces;    // Nextに表示されている5つのミノ
+    bool holdExists;                        // Holdにミノがあるか
+    bool holdUsed;                          // このターンでHoldを使ったか
+};
+
+// ==== 1回の操作 ====
+enum class Action {
+    None,
+    Left,        // 左移動
+    Right,       // 右移動
+    SoftDrop,    // 1段下へ（固定はしない）
+    Up,          // 1段上へ（デバッグ用）
+    RotateLeft,  // 左回転（Piece::rotate(board, true)）
+    RotateRight, // 右回転（Piece::rotate(board, false)）
+    HardDrop,    // 一番下まで落として固定
+    Hold,        // ホールド
+    Gravity,     // 自動落下1回分（落ちられなければ固定）
+    DasLeft,     // 左へ動けなくなるまで移動（左を押し続けて DAS が効いたのと同じ）
+    DasRight,    // 右へ動けなくなるまで移動
+    SonicDrop    // 一番下まで落とす（固定はしない、下を押し続けたのと同じ）
+};
+
+// ==== step() の結果 ====
+struct StepResult {
+    bool moved = false;        // 操作が盤面に反映されたか
+    bool locked = false;       // ピースが固定されたか
+    int linesCleared = 0;      // 固定で消えたライン数
+    bool gameOver = false;     // 新しいピースが出現できなかったか
+};
+
+// ==== 局面のスナップショット（シード付きの局面を復元するための最小限の情報） ====
+// 現在のピースと Next は「Bag(seed) から bagDraws 個引いた列の末尾6個」なので、盤面と Hold だけ持てばよい
+struct GameSnapshot {
+    std::uint64_t seed = 0;
+    std::uint32_t bagDraws = 0;                  // Bag から引いた総数
+    std::array<Board::Row, Board::HEIGHT> rows{}; // 盤面の占有ビット
+    int hold = -1;                               // Hold 中の種類（-1 なら空）
+    bool holdUsed = false;                       // このターンで Hold を使ったか
+};
+
+// ==== ウィンドウを持たないゲーム本体 ====
+class GameCore {
+private:
+    Board board;                             // 盤面（フィールド）
+    Bag bag;                                 // 7種1巡の袋
+    std::uint64_t seed = 0;                  // Bag のシード（シード指定のときだけ意味がある）
+    std::uint32_t bagDraws = 0;              // Bag から引いた総数（currentPiece より先に初期化する）
+    Piece currentPiece;                      // 現在操作中のピース
+    std::deque<PieceType> nextQueue;         // Next表示用のキュー（複数個分）
+    std::optional<Piece> holdPiece;          // Holdに入っているピース
+    bool holdUsed = false, holdExists = false; // Holdを使ったかどうか、存在するか
+    bool gameOver = false;                   // 出現位置が埋まってゲーム終了したか
+
+public:
+    static const int NEXT_COUNT = 5;         // Nextに表示する個数
+
+    GameCore();                              // コンストラクタ（Bagから最初のピースとNextを補充）
+    // Bag のシードを指定（同じシード・同じ操作なら同じ展開になる）
+    // withColors = false なら盤面の色を記録しない（描画しないヘッドレスのゲーム用）
+    explicit GameCore(std::uint64_t seed, bool withColors = true);
+    // スナップショットから復元する
+    // bagDraws が NEXT_COUNT + 1 より少なければ NEXT_COUNT + 1 として（シードの最初の局面の並びで）復元し、
+    // hold が 0〜6 の外なら Hold は空とする
+    explicit GameCore(const GameSnapshot& snapshot);
+
+    StepResult step(Action action);          // 操作を1つ適用する
+    GameState getGameState() const;          // 状態を取得する関数
+
+    // 現在のピースを (rotation, x, y) に直接置いて固定する（リプレイ再生用）
+    // 重なっている・まだ下に落ちられる位置なら何もせず locked = false を返す
+    StepResult placeAt(Rotation rotation, int x, int y);
+
+    // シード指定で始めた局面のスナップショット
+    GameSnapshot snapshot() const;
+
+    const Board& getBoard() const { return board; }
+    const Piece& getCurrentPiece() const { return currentPiece; }
+    const std::deque<PieceType>& getNextQueue() const { return nextQueue; }
+    const std::optional<Piece>& getHoldPiece() const { return holdPiece; }
+    bool isGameOver() const { return gameOver; }
+    std::uint64_t getSeed() const { return seed; }
+    // Next の後ろに続くピースが入っている袋（残りの種類、bit t が PieceType t）
+    std::uint8_t getUnseenBag() const {
+        std::uint8_t mask = bag.remainingMask();
+        return mask == 0 ? FULL_BAG : mask;
+    }
+
+private:
+    PieceType draw();                        // Bag から1つ引く（引いた数を数える）
+    void lockPiece(StepResult& result);      // 現在のピースを固定してライン消去、次を出す
+    void spawn(PieceType type);              // 指定の種類を初期位置に出現させる
+    bool hold();                             // Hold処理（使えなければ false）
+};
@@ -0,0 +1,22 @@
+#include "InputQueue.hpp"
+
+// ==================== InputQueue クラス ====================
+void InputQueue::push(const InputEvent& event) {
+    InputEvent e = event;
+    if (!events.empty() && e.timeUs < events.back().timeUs) e.timeUs = events.back().timeUs;
+    events.push_back(e);
+}
+
+bool InputQueue::pop(std::int64_t upToUs, InputEvent& out) {
+    if (events.empty() || events.front().timeUs > upToUs) return false;
+    out = events.front();
+    events.pop_front();
+    return true;
+}
+
+void pushTaps(InputQueue& queue, const std::vector<Action>& actions, std::int64_t timeUs) {
+    for (Action a : actions) {
+        queue.push(timeUs, a, true);
+        queue.push(timeUs, a, false);
+    }
+}
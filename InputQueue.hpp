@@ -0,0 +1,39 @@
+#pragma once
+#include "GameCore.hpp"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// InputQueue について
+// キーを押した・離したという出来事を、起きた時刻つきで順に貯めておくキュー
+// 画面（Game）は sf::Event の KeyPressed / KeyReleased をそのまま積み、
+// PlayerController が tick ごとに「その tick の終わりまでに起きた分」を順に取り出して適用する
+// ポーリングと違い、tick の間に押して離した短い入力も失われない
+// ボットやリプレイの操作列も pushTaps() で同じ形式にして積めるので、人と同じ経路で動かせる
+
+// ==== 1つの入力 ====
+struct InputEvent {
+    std::int64_t timeUs = 0;      // 起きた時刻（マイクロ秒、単調増加する時計で測る）
+    Action action = Action::None; // どのキーか（Left / Right / SoftDrop / 回転 / HardDrop / Hold / Up、ボットは DasLeft などの長押しも）
+    bool pressed = true;          // true = 押した、false = 離した
+};
+
+class InputQueue {
+public:
+    // 時刻の順に積むこと（前より古い時刻は前の時刻として扱う）
+    void push(const InputEvent& event);
+    void push(std::int64_t timeUs, Action action, bool pressed) { push(InputEvent{ timeUs, action, pressed }); }
+
+    // 時刻が upToUs 以下の先頭を取り出す（なければ false）
+    bool pop(std::int64_t upToUs, InputEvent& out);
+
+    bool empty() const { return events.empty(); }
+    std::size_t size() const { return events.size(); }
+    void clear() { events.clear(); }
+
+private:
+    std::deque<InputEvent> events;
+};
+
+// 操作列（BotDecision::inputs など）を、時刻 timeUs に「押してすぐ離す」入力として積む
+void pushTaps(InputQueue& queue, const std::vector<Action>& actions, std::int64_t timeUs);
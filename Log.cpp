@@ -0,0 +1,131 @@
+#include "Log.hpp"
+#include <cstdarg>
+#include <functional>
+
+const char* logLevelName(LogLevel level) {
+    switch (level) {
+    case LogLevel::Trace: return "TRACE";
+    case LogLevel::Debug: return "DEBUG";
+    case LogLevel::Info:  return "INFO";
+    case LogLevel::Warn:  return "WARN";
+    case LogLevel::Error: return "ERROR";
+    default:              return "OFF";
+    }
+}
+
+// ==================== Logger クラス ====================
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::Logger() : start(std::chrono::steady_clock::now()) {
+    for (int i = 0; i < CAPACITY; ++i) slots[i].sequence.store(i, std::memory_order_relaxed);
+    worker = std::thread([this] { drain(); });
+}
+
+// 残りを書き出してからスレッドを止める
+Logger::~Logger() {
+    running.store(false, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wake.notify_one();
+    }
+    if (worker.joinable()) worker.join();
+}
+
+void Logger::setOutput(std::FILE* file) {
+    flush();
+    output.store(file, std::memory_order_release);
+}
+
+void Logger::write(LogLevel level, const char* category, const char* format, ...) {
+    // 空きスロットを1つ確保する（他のスレッドと取り合ったら位置を取り直す）
+    std::uint64_t pos = head.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+        slot = &slots[pos & (CAPACITY - 1)];
+        std::uint64_t seq = slot->sequence.load(std::memory_order_acquire);
+        std::int64_t diff = static_cast<std::int64_t>(seq) - static_cast<std::int64_t>(pos);
+        if (diff == 0) {
+            if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        }
+        else if (diff < 0) {
+            // 1周分まだ書き出されていない＝満杯
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    Record& r = slot->record;
+    r.timeNs = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    r.thread = static_cast<std::uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+    r.level = level;
+    r.category = category;
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(r.message, MESSAGE_SIZE, format, args);
+    va_end(args);
+
+    // sequence と sleeping はどちらも seq_cst で読み書きする（drain() が空を確かめてから眠るまでの間に
+    // 積んだ場合も、drain() がこのスロットを見るか、ここで sleeping を見るかのどちらかになる）
+    slot->sequence.store(pos + 1);
+    if (sleeping.load() && sleeping.exchange(false)) {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wake.notify_one();
+    }
+}
+
+// 書き出し可能なレコードを1つ取り出す（書き出しスレッドだけが呼ぶ）
+bool Logger::pop(Record& out) {
+    Slot& slot = slots[tail & (CAPACITY - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != tail + 1) return false;
+    out = slot.record;
+    slot.sequence.store(tail + CAPACITY, std::memory_order_release);
+    ++tail;
+    return true;
+}
+
+bool Logger::readable() const {
+    return slots[tail & (CAPACITY - 1)].sequence.load() == tail + 1;
+}
+
+void Logger::flush() {
+    // drain() が追いつくまで待つ（確保済みで書き込み途中のレコードも含む）
+    std::uint64_t target = head.load(std::memory_order_acquire);
+    while (written.load(std::memory_order_acquire) < target && worker.joinable())
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+}
+
+void Logger::drain() {
+    Record r;
+    for (;;) {
+        // running を先に読んでおき、止める指示のあとに積まれた分も取りこぼさない
+        bool stop = !running.load(std::memory_order_acquire);
+        bool any = false;
+        std::FILE* out = output.load(std::memory_order_acquire);
+        if (!out) out = stderr;
+        while (pop(r)) {
+            std::fprintf(out, "[%10.6f] %-5s %08x %s: %s\n", r.timeNs * 1e-9, logLevelName(r.level),
+                r.thread, r.category, r.message);
+            written.fetch_add(1, std::memory_order_release);
+            any = true;
+        }
+        if (any) std::fflush(out);
+        if (stop) break;
+
+        // 空なら、write() が次のレコードを積むか、止める指示が来るまで眠る
+        // 起こされても次に読むスロットがまだ書き込み途中なら、sleeping を立て直してから眠り直す
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        for (;;) {
+            sleeping.store(true);
+            if (readable() || !running.load(std::memory_order_acquire)) break;
+            wake.wait(lock);
+        }
+        sleeping.store(false, std::memory_order_relaxed);
+    }
+}
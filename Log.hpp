@@ -0,0 +1,129 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+// Logger について
+// ゲームの処理中に std::cout へ直接書くと、その場でコンソール出力を待つことになり1手ごとの処理が重くなる
+// そこでログは固定長のレコードにしてロックフリーのリングバッファへ積むだけにし、
+// 書き出しはバックグラウンドのスレッドがまとめて行う
+// 書き出しスレッドはリングが空のあいだ条件変数で眠り、眠っているときに積んだ write() だけが起こす
+// （ログが来なければ一切起きないので、ライブラリに組み込んでも CPU を使わない）
+//
+// レベルは2段階で絞る
+//   コンパイル時: TETRIS_LOG_LEVEL より下のレベルのマクロは if constexpr で消え、実行時のコストは 0 になる
+//                 （指定がなければ NDEBUG のリリースビルドは Info、デバッグビルドは Trace）
+//   実行時:       Logger::instance().setLevel() で、コンパイル時に残したレベルをさらに絞る（既定は Info）
+//
+// 使い方:
+//   LOG_DEBUG("piece", "rotation blocked type=%s", pieceTypeToString(type).c_str());
+// category は文字列リテラルなど、プログラムの終わりまで残る文字列を渡すこと
+
+enum class LogLevel : int {
+    Trace = 0,   // 1操作ごとの細かい記録（回転の成否など）
+    Debug = 1,   // ゲーム進行の記録（Hold など）
+    Info = 2,    // 起動・終了などの通常の記録
+    Warn = 3,    // 続行できるが想定外のこと
+    Error = 4,   // 処理を続けられないこと
+    Off = 5
+};
+
+#ifndef TETRIS_LOG_LEVEL
+#ifdef NDEBUG
+#define TETRIS_LOG_LEVEL 2
+#else
+#define TETRIS_LOG_LEVEL 0
+#endif
+#endif
+
+const char* logLevelName(LogLevel level);
+
+class Logger {
+public:
+    static const int CAPACITY = 1024;          // リングバッファのレコード数（2 の累乗）
+    static const int MESSAGE_SIZE = 112;       // 1レコードの本文の最大長（超えた分は切り捨て）
+
+    // ==== 1件のログ（生成側でフォーマット済み） ====
+    struct Record {
+        std::uint64_t timeNs;                  // Logger 作成からの経過時間
+        std::uint32_t thread;                  // 書いたスレッドの番号（短いハッシュ）
+        LogLevel level;
+        const char* category;
+        char message[MESSAGE_SIZE];
+    };
+
+    // プロセスで1つのロガー（最初に使ったときに書き出しスレッドを起動する）
+    static Logger& instance();
+
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    bool enabled(LogLevel level) const {
+        return static_cast<int>(level) >= minLevel.load(std::memory_order_relaxed);
+    }
+    void setLevel(LogLevel level) { minLevel.store(static_cast<int>(level), std::memory_order_relaxed); }
+
+    // 書き出し先を変える（nullptr なら stderr。ファイルの close は呼び出し元が行う）
+    void setOutput(std::FILE* file);
+
+    // フォーマットしてリングバッファに積む（満杯なら捨てて dropped を数える。待たない）
+#if defined(__GNUC__)
+    __attribute__((format(printf, 4, 5)))
+#endif
+    void write(LogLevel level, const char* category, const char* format, ...);
+
+    // ここまでに積まれたレコードがすべて書き出されるまで待つ
+    void flush();
+
+    // 満杯で捨てたレコードの数
+    std::uint64_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    Logger();
+
+    // 複数生成・単一消費のリングバッファの1スロット
+    // sequence がスロットの状態を表す（書き込み可能 / 読み出し可能 を位置と比べて判定する）
+    struct Slot {
+        std::atomic<std::uint64_t> sequence;
+        Record record;
+    };
+
+    bool pop(Record& out);
+    bool readable() const;                     // 次に読むスロットが書き込み済みか（書き出しスレッドのみ）
+    void drain();                              // 書き出しスレッドの本体
+
+    Slot slots[CAPACITY];
+    alignas(64) std::atomic<std::uint64_t> head{ 0 };    // 次に書く位置（生成側）
+    alignas(64) std::uint64_t tail = 0;                  // 次に読む位置（書き出しスレッドのみ）
+    alignas(64) std::atomic<std::uint64_t> written{ 0 }; // 書き出し済みの数（flush 用）
+    std::atomic<std::uint64_t> dropped{ 0 };
+    std::atomic<int> minLevel{ static_cast<int>(LogLevel::Info) };
+    std::atomic<std::FILE*> output{ nullptr };
+    std::atomic<bool> running{ true };
+    std::atomic<bool> sleeping{ false };       // 書き出しスレッドが空のリングで眠っている（起こすのは1回だけ）
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::chrono::steady_clock::time_point start;
+    std::thread worker;
+};
+
+// ==== ログ用マクロ ====
+// コンパイル時に除外されたレベルでは引数の式も評価されない
+#define TETRIS_LOG(level, category, ...)                                              \
+    do {                                                                              \
+        if constexpr (static_cast<int>(level) >= TETRIS_LOG_LEVEL) {                  \
+            if (Logger::instance().enabled(level))                                    \
+                Logger::instance().write(level, category, __VA_ARGS__);               \
+        }                                                                             \
+    } while (0)
+
+#define LOG_TRACE(category, ...) TETRIS_LOG(LogLevel::Trace, category, __VA_ARGS__)
+#define LOG_DEBUG(category, ...) TETRIS_LOG(LogLevel::Debug, category, __VA_ARGS__)
+#define LOG_INFO(category, ...)  TETRIS_LOG(LogLevel::Info, category, __VA_ARGS__)
+#define LOG_WARN(category, ...)  TETRIS_LOG(LogLevel::Warn, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...) TETRIS_LOG(LogLevel::Error, category, __VA_ARGS__)
@@ -0,0 +1,144 @@
+#include "Metrics.hpp"
+#include "BitOps.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <sstream>
+
+const char* counterName(Counter counter) {
+    switch (counter) {
+    case Counter::PiecesPlaced:    return "pieces_placed";
+    case Counter::LineClear1:      return "line_clear_1";
+    case Counter::LineClear2:      return "line_clear_2";
+    case Counter::LineClear3:      return "line_clear_3";
+    case Counter::LineClear4:      return "line_clear_4";
+    case Counter::RotationKick1:   return "rotation_kick_1";
+    case Counter::RotationKick2:   return "rotation_kick_2";
+    case Counter::RotationKick3:   return "rotation_kick_3";
+    case Counter::RotationKick4:   return "rotation_kick_4";
+    case Counter::RotationKick5:   return "rotation_kick_5";
+    case Counter::RotationBlocked: return "rotation_blocked";
+    case Counter::Holds:           return "holds";
+    default:                       return "?";
+    }
+}
+
+const char* phaseName(Phase phase) {
+    switch (phase) {
+    case Phase::HandleEvents: return "handle_events";
+    case Phase::HandleInput:  return "handle_input";
+    case Phase::HandleFall:   return "handle_fall";
+    case Phase::Render:       return "render";
+    default:                  return "?";
+    }
+}
+
+// ==================== LatencyHistogram クラス ====================
+std::uint64_t LatencyHistogram::percentileNs(double p) const {
+    if (count == 0) return 0;
+    std::uint64_t target = static_cast<std::uint64_t>(std::max(0.0, std::min(1.0, p)) * (count - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; ++b) {
+        seen += buckets[b];
+        if (seen >= target) return std::min(bucketLimitNs(b), maxNs);
+    }
+    return maxNs;
+}
+
+// ==================== MetricsSnapshot クラス ====================
+// 1行に1つ "name value"。ヒストグラムは phase.<段階>.<項目> と、空でない区間を phase.<段階>.lt_<上端ns> で出す
+std::string MetricsSnapshot::toString() const {
+    std::ostringstream out;
+    for (int c = 0; c < static_cast<int>(Counter::Count); ++c)
+        out << counterName(static_cast<Counter>(c)) << ' ' << counters[c] << '\n';
+    for (int p = 0; p < static_cast<int>(Phase::Count); ++p) {
+        const LatencyHistogram& h = phases[p];
+        std::string prefix = std::string("phase.") + phaseName(static_cast<Phase>(p)) + '.';
+        out << prefix << "count " << h.count << '\n'
+            << prefix << "mean_ns " << static_cast<std::uint64_t>(h.meanNs()) << '\n'
+            << prefix << "p50_ns " << h.percentileNs(0.50) << '\n'
+            << prefix << "p99_ns " << h.percentileNs(0.99) << '\n'
+            << prefix << "max_ns " << h.maxNs << '\n';
+        for (int b = 0; b < LatencyHistogram::BUCKETS; ++b)
+            if (h.buckets[b]) out << prefix << "lt_" << LatencyHistogram::bucketLimitNs(b) << ' ' << h.buckets[b] << '\n';
+    }
+    return out.str();
+}
+
+// ==================== Metrics クラス ====================
+Metrics& Metrics::instance() {
+    static Metrics metrics;
+    return metrics;
+}
+
+void Metrics::record(Phase phase, std::uint64_t ns) {
+    if constexpr (TETRIS_METRICS != 0) {
+        auto& h = local().phases[static_cast<int>(phase)];
+        auto add = [](std::atomic<std::uint64_t>& v, std::uint64_t n) {
+            v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        };
+        add(h.buckets[std::min(bitWidth(ns), LatencyHistogram::BUCKETS - 1)], 1);
+        add(h.count, 1);
+        add(h.totalNs, ns);
+        if (ns > h.maxNs.load(std::memory_order_relaxed)) h.maxNs.store(ns, std::memory_order_relaxed);
+    }
+}
+
+MetricsSnapshot Metrics::snapshot() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    MetricsSnapshot out = retired;
+    for (const ThreadMetrics* t : threads) t->addTo(out);
+    return out;
+}
+
+void Metrics::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    retired = MetricsSnapshot();
+    for (ThreadMetrics* t : threads) t->clear();
+}
+
+bool Metrics::dump(const std::string& path) const {
+    std::string text = snapshot().toString();
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return false;
+    bool ok = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+void Metrics::ThreadMetrics::addTo(MetricsSnapshot& out) const {
+    for (int c = 0; c < static_cast<int>(Counter::Count); ++c)
+        out.counters[c] += counters[c].load(std::memory_order_relaxed);
+    for (int p = 0; p < static_cast<int>(Phase::Count); ++p) {
+        const Histogram& from = phases[p];
+        LatencyHistogram& to = out.phases[p];
+        for (int b = 0; b < LatencyHistogram::BUCKETS; ++b) to.buckets[b] += from.buckets[b].load(std::memory_order_relaxed);
+        to.count += from.count.load(std::memory_order_relaxed);
+        to.totalNs += from.totalNs.load(std::memory_order_relaxed);
+        to.maxNs = std::max(to.maxNs, from.maxNs.load(std::memory_order_relaxed));
+    }
+}
+
+void Metrics::ThreadMetrics::clear() {
+    for (auto& c : counters) c.store(0, std::memory_order_relaxed);
+    for (auto& h : phases) {
+        for (auto& b : h.buckets) b.store(0, std::memory_order_relaxed);
+        h.count.store(0, std::memory_order_relaxed);
+        h.totalNs.store(0, std::memory_order_relaxed);
+        h.maxNs.store(0, std::memory_order_relaxed);
+    }
+}
+
+Metrics::LocalHandle::LocalHandle() : metrics(new ThreadMetrics()) {
+    Metrics& m = instance();
+    std::lock_guard<std::mutex> lock(m.mutex);
+    m.threads.push_back(metrics);
+}
+
+Metrics::LocalHandle::~LocalHandle() {
+    Metrics& m = instance();
+    {
+        std::lock_guard<std::mutex> lock(m.mutex);
+        metrics->addTo(m.retired);
+        m.threads.erase(std::find(m.threads.begin(), m.threads.end(), metrics));
+    }
+    delete metrics;
+}
@@ -0,0 +1,161 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Metrics について
+// プロファイラをつながなくても、どの処理が何回起きたか・フレームのどこに時間がかかったかを見るための計測
+//   カウンタ:   置いたピース、消したライン数ごとの回数、回転が何番目のキックで成功したか、回転の失敗、Hold
+//   ヒストグラム: フレームの各段階（イベント処理・入力・落下・描画）の所要時間（2の累乗ごとの区間）
+//
+// 記録はスレッドごとの領域に書くだけで、排他もスレッド間のキャッシュの取り合いも起きない
+// （多数の GameCore を並列に進めても、同じ変数を奪い合わない）。読み出すときに全スレッドの分を足す
+//
+// 使い方:
+//   Metrics::count(Counter::Holds);
+//   { PhaseTimer timer(Phase::Render); ... }        // スコープを抜けるまでの時間を記録する
+//   MetricsSnapshot s = Metrics::instance().snapshot();
+//   Metrics::instance().dump("metrics.txt");
+//
+// TETRIS_METRICS を 0 にしてビルドすると、記録する側の処理はすべて消える
+
+#ifndef TETRIS_METRICS
+#define TETRIS_METRICS 1
+#endif
+
+// ==== カウンタの種類 ====
+enum class Counter : int {
+    PiecesPlaced,
+    LineClear1, LineClear2, LineClear3, LineClear4,          // n ライン同時に消した回数
+    RotationKick1, RotationKick2, RotationKick3,             // 回転が n 番目のキック（1 がキックなし）で成功した回数
+    RotationKick4, RotationKick5,
+    RotationBlocked,                                         // どのキックでも回れなかった回数
+    Holds,
+    Count
+};
+
+// ==== 時間を測る段階（Game のメインループ） ====
+enum class Phase : int {
+    HandleEvents,   // ウィンドウのイベントを読んで入力の列に積む
+    HandleInput,    // tick で入力を適用する（移動・回転・Hold・DAS / ARR）
+    HandleFall,     // tick で重力と固定猶予を適用する
+    Render,         // 描画
+    Count
+};
+
+const char* counterName(Counter counter);
+const char* phaseName(Phase phase);
+
+// n ライン消したときのカウンタ（n は 1〜4）
+inline Counter lineClearCounter(int lines) {
+    return static_cast<Counter>(static_cast<int>(Counter::LineClear1) + lines - 1);
+}
+// kick 番目（0 から）のキックで回ったときのカウンタ
+inline Counter rotationKickCounter(int kick) {
+    return static_cast<Counter>(static_cast<int>(Counter::RotationKick1) + kick);
+}
+
+// ==== 所要時間のヒストグラム ====
+// 区間 b には bitWidth(ns) == b の値が入る（b = 0 は 0ns、b >= 1 は [2^(b-1), 2^b) ns）
+struct LatencyHistogram {
+    static const int BUCKETS = 48;   // 2^47 ns（約39時間）以上は最後の区間にまとめる
+
+    std::uint64_t buckets[BUCKETS] = {};
+    std::uint64_t count = 0;
+    std::uint64_t totalNs = 0;
+    std::uint64_t maxNs = 0;
+
+    double meanNs() const { return count ? static_cast<double>(totalNs) / count : 0.0; }
+    // 下から割合 p（0〜1）の位置にある値が入っている区間の上端
+    std::uint64_t percentileNs(double p) const;
+    // 区間 b の上端（この値未満が入る）
+    static std::uint64_t bucketLimitNs(int b) { return b >= 63 ? ~std::uint64_t(0) : std::uint64_t(1) << b; }
+};
+
+// ==== 読み出した値（全スレッドの合計） ====
+struct MetricsSnapshot {
+    std::uint64_t counters[static_cast<int>(Counter::Count)] = {};
+    LatencyHistogram phases[static_cast<int>(Phase::Count)];
+
+    std::uint64_t operator[](Counter c) const { return counters[static_cast<int>(c)]; }
+    const LatencyHistogram& operator[](Phase p) const { return phases[static_cast<int>(p)]; }
+
+    // "name value" を1行ずつ並べた文字列（dump で書く内容）
+    std::string toString() const;
+};
+
+class Metrics {
+public:
+    static Metrics& instance();
+
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    static void count(Counter counter, std::uint64_t n = 1) {
+        if constexpr (TETRIS_METRICS != 0) {
+            std::atomic<std::uint64_t>& c = local().counters[static_cast<int>(counter)];
+            c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+        }
+    }
+    static void record(Phase phase, std::uint64_t ns);
+
+    // すべてのスレッドの分を足して返す
+    MetricsSnapshot snapshot() const;
+    // すべて 0 に戻す（記録中のスレッドがあると、その瞬間の数件は消えずに残ることがある）
+    void reset();
+    // snapshot().toString() をファイルに書く
+    bool dump(const std::string& path) const;
+
+private:
+    Metrics() {}
+
+    // 1スレッド分の記録（書くのはそのスレッドだけなので、足し算は読んで書くだけでよい）
+    struct alignas(64) ThreadMetrics {
+        std::atomic<std::uint64_t> counters[static_cast<int>(Counter::Count)] = {};
+        struct Histogram {
+            std::atomic<std::uint64_t> buckets[LatencyHistogram::BUCKETS] = {};
+            std::atomic<std::uint64_t> count{ 0 }, totalNs{ 0 }, maxNs{ 0 };
+        } phases[static_cast<int>(Phase::Count)];
+
+        void addTo(MetricsSnapshot& out) const;
+        void clear();
+    };
+
+    // スレッドが終わるときに、その分を retired に足して登録を外す
+    struct LocalHandle {
+        ThreadMetrics* metrics;
+        LocalHandle();
+        ~LocalHandle();
+    };
+
+    static ThreadMetrics& local() {
+        thread_local LocalHandle handle;
+        return *handle.metrics;
+    }
+
+    mutable std::mutex mutex;                  // threads と retired を守る
+    std::vector<ThreadMetrics*> threads;
+    MetricsSnapshot retired;                   // 終わったスレッドの分
+};
+
+// ==== スコープの所要時間を Phase に記録する ====
+class PhaseTimer {
+public:
+    explicit PhaseTimer(Phase phase) : phase(phase) {
+        if constexpr (TETRIS_METRICS != 0) start = std::chrono::steady_clock::now();
+    }
+    ~PhaseTimer() {
+        if constexpr (TETRIS_METRICS != 0)
+            Metrics::record(phase, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count()));
+    }
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+    Phase phase;
+    std::chrono::steady_clock::time_point start;
+};
@@ -0,0 +1,224 @@
+#include "MoveGen.hpp"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+    // 回転状態 r と同じ形（平行移動で重なる）になる最小の回転状態
+    // S/Z/I は 0 と 2、1 と 3 が、O は4つすべてが同じ形になる
+    std::array<std::array<int, 4>, 7> makeCanonicalRotations() {
+        std::array<std::array<int, 4>, 7> canon{};
+        for (int t = 0; t < 7; t++) {
+            for (int r = 0; r < 4; r++) {
+                canon[t][r] = r;
+                for (int s = 0; s < r; s++) {
+                    const PieceMask& a = SRS_MASKS[t][r];
+                    const PieceMask& b = SRS_MASKS[t][s];
+                    if (a.width == b.width && a.height == b.height && a.mask == b.mask) {
+                        canon[t][r] = s;
+                        break;
+                    }
+                }
+            }
+        }
+        return canon;
+    }
+
+    const std::array<std::array<int, 4>, 7> CANONICAL_ROTATION = makeCanonicalRotations();
+
+    // 下向きのキックで動く最大の段数
+    const int MAX_KICK_DROP = [] {
+        int drop = 0;
+        for (const auto& type : SRS_KICKS)
+            for (const auto& from : type)
+                for (const KickList& kicks : from)
+                    for (int i = 0; i < kicks.count; i++) drop = std::max(drop, kicks.delta[i].y);
+        return drop;
+    }();
+
+    // 何もない場所で Spawn から回転状態 r まで回したときの位置のずれ（最初のキック候補で入る）
+    // r = 1, 2 は左回転、r = 3 は右回転1回で回す
+    void openRotationShift(int t, int r, int& dx, int& dy) {
+        dx = dy = 0;
+        int from = 0;
+        int steps = r == 3 ? 1 : r;
+        int dir = r == 3 ? 1 : 0;
+        for (int i = 0; i < steps; i++) {
+            const KickList& kicks = SRS_KICKS[t][from][dir];
+            dx += kicks.delta[0].x;
+            dy += kicks.delta[0].y;
+            from = (from + (dir == 0 ? 1 : 3)) % 4;
+        }
+    }
+
+    // 回転状態 r の (x, y) が、盤面の横幅と上端の内側で、かつ openRows 行より上に収まるか
+    bool insideOpenRows(const PieceMask& mask, int x, int y, int openRows) {
+        return x + mask.minX >= 0 && x + mask.minX + mask.width <= Board::WIDTH
+            && y + mask.minY >= 0 && y + mask.minY + mask.height <= openRows;
+    }
+
+}
+
+// 最終配置を盤面に固定してライン消去する
+int applyPlacement(BitBoard& board, const Placement& placement) {
+    int t = static_cast<int>(placement.type);
+    board.placeMask(SRS_MASKS[t][static_cast<int>(placement.rotation)], placement.x, placement.y);
+    return board.clearLines();
+}
+
+int canonicalRotation(PieceType type, Rotation rotation) {
+    return CANONICAL_ROTATION[static_cast<int>(type)][static_cast<int>(rotation)];
+}
+
+MoveGenerator::MoveGenerator() {}
+
+// 到達可能な最終配置をすべて列挙する
+int MoveGenerator::generate(const BitBoard& board, PieceType type, std::vector<Placement>& out) {
+    out.clear();
+
+    // stamp が一周したら配列を初期化し直す
+    if (++stamp == 0) {
+        visited.fill(0);
+        landed.fill(0);
+        stamp = 1;
+    }
+
+    const int t = static_cast<int>(type);
+    const auto& masks = SRS_MASKS[t];
+
+    // 出現位置（Piece のコンストラクタと同じ x=3, y=0, Spawn）
+    Piece spawn(type);
+    if (board.overlaps(masks[0], spawn.x, spawn.y)) return 0;
+
+    int head = 0, tail = 0;
+
+    // --- 積みが低ければ、積みのすぐ上の段から探索を始める ---
+    // openRows 行より上は空いているので、出現位置から落として回し、左右に動かせば
+    // その範囲のどの状態にも行ける。空いた範囲から外へ出る手（落下・下向きのキック）は
+    // 一番下の MAX_KICK_DROP 段ぶんの状態からしか起きないので、そこだけを始点にする
+    int openRows = 0;
+    while (openRows < Board::HEIGHT && board.rows[openRows] == 0) openRows++;
+    int seedTop = Board::HEIGHT;
+    for (int r = 0; r < 4; r++) seedTop = std::min(seedTop, openRows - masks[r].minY - masks[r].height);
+    seedTop -= MAX_KICK_DROP;
+    openStartY = seedTop - 2;    // 回転で位置が少しずれても始点の段より上に収まるよう余裕をとる
+    for (int r = 0; r < 4 && openStartY >= 0; r++) {
+        // 出現位置の向きで openStartY まで落とし、回転したあとの位置が空いた範囲に収まり、
+        // 始点の段より上にあること（回転の途中の向きも確かめる）
+        int steps = r == 3 ? 1 : r;
+        for (int i = 0; i <= steps && openStartY >= 0; i++) {
+            int step = r == 3 ? 3 * i : i;
+            int dx, dy;
+            openRotationShift(t, step, dx, dy);
+            if (!insideOpenRows(masks[step], spawn.x + dx, openStartY + dy, openRows) || openStartY + dy > seedTop)
+                openStartY = -1;
+        }
+    }
+    if (openStartY >= 0 && openStartY >= spawn.y) {
+        for (int r = 0; r < 4; r++) {
+            const PieceMask& mask = masks[r];
+            int low = openRows - mask.minY - mask.height;
+            for (int y = seedTop; y <= low; y++) {
+                for (int x = -mask.minX; x + mask.minX + mask.width <= Board::WIDTH; x++) {
+                    int n = index(x, y, r);
+                    visited[n] = stamp;
+                    parent[n] = OPEN_START;
+                    queue[tail++] = static_cast<std::int16_t>(n);
+                }
+            }
+        }
+    }
+    else {
+        openStartY = -1;
+        int start = index(spawn.x, spawn.y, 0);
+        visited[start] = stamp;
+        parent[start] = -1;
+        queue[tail++] = static_cast<std::int16_t>(start);
+    }
+
+    while (head < tail) {
+        int s = queue[head++];
+        int x = s % SPAN_X - MARGIN;
+        int y = (s / SPAN_X) % SPAN_Y - MARGIN;
+        int r = s / (SPAN_X * SPAN_Y);
+        const PieceMask& mask = masks[r];
+
+        // 次の状態を登録する（未訪問なら親と操作を記録してキューに積む）
+        auto push = [&](int nx, int ny, int nr, Action action) {
+            int n = index(nx, ny, nr);
+            if (visited[n] == stamp) return;
+            visited[n] = stamp;
+            parent[n] = static_cast<std::int16_t>(s);
+            via[n] = action;
+            queue[tail++] = static_cast<std::int16_t>(n);
+        };
+
+        // --- 左右移動・ソフトドロップ ---
+        if (!board.overlaps(mask, x - 1, y)) push(x - 1, y, r, Action::Left);
+        if (!board.overlaps(mask, x + 1, y)) push(x + 1, y, r, Action::Right);
+        bool grounded = board.overlaps(mask, x, y + 1);
+        if (!grounded) push(x, y + 1, r, Action::SoftDrop);
+
+        // --- 回転（Piece::rotate と同じ順にキックを試し、最初に入れた位置だけが有効） ---
+        for (int dir = 0; dir < 2; dir++) {
+            int nr = (r + (dir == 0 ? 1 : 3)) % 4;
+            const KickList& kicks = SRS_KICKS[t][r][dir];
+            for (int i = 0; i < kicks.count; i++) {
+                int nx = x + kicks.delta[i].x, ny = y + kicks.delta[i].y;
+                if (!board.overlaps(masks[nr], nx, ny)) {
+                    push(nx, ny, nr, dir == 0 ? Action::RotateLeft : Action::RotateRight);
+                    break;
+                }
+            }
+        }
+
+        // --- 着地している状態は最終配置（埋まるマスが同じものは最初の1つだけ） ---
+        if (grounded) {
+            int canon = CANONICAL_ROTATION[t][r];
+            int key = index(x + mask.minX, y + mask.minY, canon);
+            if (landed[key] != stamp) {
+                landed[key] = stamp;
+                out.push_back(Placement{ type, static_cast<Rotation>(r), x, y });
+            }
+        }
+    }
+
+    return static_cast<int>(out.size());
+}
+
+// 直前の探索の親をたどって操作列を復元する
+std::vector<Action> MoveGenerator::pathTo(const Placement& placement) const {
+    std::vector<Action> path;
+    int s = index(placement.x, placement.y, static_cast<int>(placement.rotation));
+    if (visited[s] != stamp) return path;
+
+    while (parent[s] >= 0) {
+        path.push_back(via[s]);
+        s = parent[s];
+    }
+
+    // 空いた行から始めた状態なら、出現位置から落として回し、左右に動かしてそこまで落とす
+    if (parent[s] == OPEN_START) {
+        int t = static_cast<int>(placement.type);
+        int x = s % SPAN_X - MARGIN;
+        int y = (s / SPAN_X) % SPAN_Y - MARGIN;
+        int r = s / (SPAN_X * SPAN_Y);
+        Piece spawn(placement.type);
+        int dx, dy;
+        openRotationShift(t, r, dx, dy);
+        int fromX = spawn.x + dx, fromY = openStartY + dy;
+
+        // 逆順に積んでいるので、出現位置から遠い操作から入れる
+        path.insert(path.end(), y - fromY, Action::SoftDrop);
+        path.insert(path.end(), std::abs(x - fromX), x > fromX ? Action::Right : Action::Left);
+        if (r == 3) path.push_back(Action::RotateRight);
+        else path.insert(path.end(), r, Action::RotateLeft);
+        path.insert(path.end(), openStartY - spawn.y, Action::SoftDrop);
+    }
+    std::reverse(path.begin(), path.end());
+
+    // 末尾のソフトドロップはハードドロップで代用できる
+    while (!path.empty() && path.back() == Action::SoftDrop) path.pop_back();
+    path.push_back(Action::HardDrop);
+    return path;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include "Board.hpp"
+#include "Piece.hpp"
+#include "GameCore.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// MoveGenerator について
+// 出現位置(x=3, y=0, Spawn)から、左右移動・ソフトドロップ・SRS回転（キック込み）だけで
+// たどり着ける状態を幅優先探索し、それ以上下に落ちられない「最終配置」をすべて列挙する
+// 判定は Piece::canMove / Piece::collides と同じ規則を SRS_MASKS / SRS_KICKS で直接行うので、
+// Piece をコピーして1手ずつ動かす必要がない
+// 最終的に埋まるマスが同じ配置（S/Z/I の表裏、O の回転など）は1つにまとめる
+// 積みが低いときは、積みより上の空いた行を1段ずつたどらず、積みのすぐ上の数段にある
+// すべての向き・列の状態から探索を始める（空いた行の中ならどの状態にも出現位置から行ける）
+
+// ==== 最終配置（ハードドロップ直前のピースの位置と向き） ====
+struct Placement {
+    PieceType type;
+    Rotation rotation;
+    int x, y;
+};
+
+// 最終配置を盤面に固定してライン消去し、消した行数を返す
+int applyPlacement(BitBoard& board, const Placement& placement);
+
+// 回転状態 rotation と同じ形（平行移動で重なる）になる最小の回転状態
+int canonicalRotation(PieceType type, Rotation rotation);
+
+class MoveGenerator {
+public:
+    // 探索する座標の範囲（ピース原点がはみ出してもよいよう、盤面の外側に余白をとる）
+    static const int MARGIN = 3;
+    static const int SPAN_X = Board::WIDTH + 2 * MARGIN;
+    static const int SPAN_Y = Board::HEIGHT + 2 * MARGIN;
+    static const int STATE_COUNT = 4 * SPAN_X * SPAN_Y;
+
+    MoveGenerator();
+
+    // 到達可能な最終配置をすべて out に書き出し（out は上書き）、その数を返す
+    // 出現位置が埋まっている場合は 0
+    int generate(const BitBoard& board, PieceType type, std::vector<Placement>& out);
+
+    // 直前の generate() で見つけた配置までの操作列（最後は HardDrop）
+    // 同じ盤面・種類で generate() した直後にだけ使える
+    std::vector<Action> pathTo(const Placement& placement) const;
+
+private:
+    // 状態 (x, y, rotation) の通し番号
+    static int index(int x, int y, int rotation) {
+        return (rotation * SPAN_Y + (y + MARGIN)) * SPAN_X + (x + MARGIN);
+    }
+
+    // parent がこの値なら、空いた行から探索を始めた状態（pathTo で出現位置からの操作を補う）
+    static const std::int16_t OPEN_START = -2;
+    int openStartY = -1;    // 空いた行から始めたとき、出現位置の向きのまま落とす行（-1 なら出現位置から探索した）
+
+    // 探索ごとに stamp を進め、配列を毎回クリアしなくて済むようにする
+    std::uint32_t stamp = 0;
+    std::array<std::uint32_t, STATE_COUNT> visited{};   // 訪問済みなら stamp
+    std::array<std::uint32_t, STATE_COUNT> landed{};    // 同じマスを埋める配置を登録済みなら stamp
+    std::array<std::int16_t, STATE_COUNT> parent{};     // 1つ前の状態
+    std::array<Action, STATE_COUNT> via{};              // 1つ前の状態からの操作
+    std::array<std::int16_t, STATE_COUNT> queue{};      // 幅優先探索のキュー
+};
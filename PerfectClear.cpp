@@ -0,0 +1,166 @@
+#include "PerfectClear.hpp"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+    std::int64_t nowUs() {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // 領域（下から height 段）を、上から下まで埋まった列で左右に区切ったとき、
+    // どの区間の空きマスも4の倍数か（ピースは埋まった列をまたげず、ライン消去でもこの列は埋まったまま）
+    bool wallPartsFillable(const BitBoard& board, int height) {
+        BitBoard::Row fullColumns = BitBoard::FULL_ROW;
+        for (int y = BitBoard::HEIGHT - height; y < BitBoard::HEIGHT; ++y) fullColumns &= board.rows[y];
+        if (fullColumns == 0) return true;
+
+        int empty = 0;
+        for (int x = 0; x < BitBoard::WIDTH; ++x) {
+            if ((fullColumns >> x) & 1u) {
+                if (empty % 4 != 0) return false;
+                empty = 0;
+                continue;
+            }
+            for (int y = BitBoard::HEIGHT - height; y < BitBoard::HEIGHT; ++y) empty += ((board.rows[y] >> x) & 1u) ? 0 : 1;
+        }
+        return empty % 4 == 0;
+    }
+
+    int holdCount(const std::vector<PcStep>& steps) {
+        int n = 0;
+        for (const auto& s : steps) n += s.useHold ? 1 : 0;
+        return n;
+    }
+}
+
+// ==================== PerfectClearSolver クラス ====================
+PerfectClearSolver::PerfectClearSolver(const PcConfig& config)
+    : config(config)
+{
+    // 4段 × 10列 を埋めるのに最大 10 個、Hold しない手とする手で2つずつ
+    int maxPieces = BitBoard::WIDTH * std::max(config.maxLines, 1) / 4 + 1;
+    buffers.resize(maxPieces * 2);
+}
+
+PcResult PerfectClearSolver::solve(const GameCore& core) {
+    std::vector<PieceType> next(core.getNextQueue().begin(), core.getNextQueue().end());
+    std::optional<PieceType> hold;
+    if (core.getHoldPiece()) hold = core.getHoldPiece()->type;
+    firstHoldAllowed = !core.getGameState().holdUsed;
+    PcResult r = solve(core.getBoard(), core.getCurrentPiece().type, hold, next);
+    firstHoldAllowed = true;
+    return r;
+}
+
+PcResult PerfectClearSolver::solve(const BitBoard& board, PieceType current, std::optional<PieceType> hold,
+    const std::vector<PieceType>& next) {
+    PcResult r;
+    result = &r;
+    queue = &next;
+    deadlineUs = config.timeBudgetUs > 0 ? nowUs() + config.timeBudgetUs : 0;
+    failed.clear();
+
+    SearchState state;
+    state.board = board;
+    state.current = static_cast<std::int8_t>(current);
+    state.hold = hold ? static_cast<std::int8_t>(*hold) : -1;
+    state.cursor = 0;
+
+    // 空きマスが4の倍数になる段数だけを、少ない段数から試す
+    int stackHeight = *std::max_element(board.heights.begin(), board.heights.end());
+    for (int lines = std::max(stackHeight, 1); lines <= config.maxLines; ++lines) {
+        int empty = lines * BitBoard::WIDTH - board.cellCount;
+        if (empty <= 0 || empty % 4 != 0) continue;
+        failed.clear();
+        path.clear();
+        search(state, lines);
+        if (r.found || r.timedOut) {
+            if (r.found) r.lines = lines;
+            break;
+        }
+    }
+
+    queue = nullptr;
+    result = nullptr;
+    return r;
+}
+
+bool PerfectClearSolver::outOfTime() {
+    if (result->timedOut) return true;
+    if (deadlineUs != 0 && (result->nodes & 63) == 0 && nowUs() > deadlineUs) result->timedOut = true;
+    return result->timedOut;
+}
+
+bool PerfectClearSolver::search(SearchState& state, int height) {
+    ++result->nodes;
+    const BitBoard& b = state.board;
+
+    // --- 盤面が空になった ---
+    if (b.cellCount == 0 && !path.empty()) {
+        if (!result->found || holdCount(path) < holdCount(result->best)) result->best = path;
+        result->found = true;
+        if (config.findAll) result->solutions.push_back(path);
+        return true;
+    }
+    if (outOfTime()) return false;
+
+    // --- 枝刈り：残りのピースで空きを埋め切れるか ---
+    int empty = height * BitBoard::WIDTH - b.cellCount;
+    int piecesLeft = (state.current >= 0 ? 1 : 0) + (state.hold >= 0 ? 1 : 0)
+        + static_cast<int>(queue->size()) - state.cursor;
+    if (empty <= 0 || empty % 4 != 0 || empty / 4 > piecesLeft) return false;
+    if (!wallPartsFillable(b, height)) return false;
+
+    // --- メモ化：同じ局面で解がないと分かっていれば探さない ---
+    std::uint64_t key = state.key() ^ zobristMix(static_cast<std::uint64_t>(height));
+    if (failed.count(key)) return false;
+
+    bool found = false;
+    int depth = static_cast<int>(path.size());
+    int regionTop = BitBoard::HEIGHT - height;
+
+    // 置くピースの候補：そのまま置く / Hold してから置く（findAll なら解があっても Hold する手も探す）
+    for (int option = 0; option < 2 && (config.findAll || !found); ++option) {
+        bool useHold = option == 1;
+        int piece = state.current;
+        if (useHold) {
+            if (!config.useHold || (depth == 0 && !firstHoldAllowed)) break;
+            if (state.hold >= 0) piece = state.hold;
+            else if (state.cursor < static_cast<int>(queue->size())) piece = static_cast<int>((*queue)[state.cursor]);
+            else break;
+            if (piece == state.current) break;   // 同じ種類なら置ける位置も同じ
+        }
+        if (piece < 0) continue;
+
+        std::vector<Placement>& placements = buffers[depth * 2 + option];
+        gen.generate(b, static_cast<PieceType>(piece), placements);
+        // 下の段を埋める配置から試す（空いたまま下に残る段ができにくく、解に早く着く）
+        std::stable_sort(placements.begin(), placements.end(), [piece](const Placement& a, const Placement& c) {
+            const PieceMask& ma = SRS_MASKS[piece][static_cast<int>(a.rotation)];
+            const PieceMask& mc = SRS_MASKS[piece][static_cast<int>(c.rotation)];
+            return a.y + ma.minY + ma.height > c.y + mc.minY + mc.height;
+        });
+        for (const Placement& p : placements) {
+            // 領域の外にはみ出す配置は使わない
+            const PieceMask& m = SRS_MASKS[piece][static_cast<int>(p.rotation)];
+            if (p.y + m.minY < regionTop) continue;
+
+            int lines = journal.apply(state, *queue, useHold, p);
+            if (lines < 0) continue;
+            path.push_back(PcStep{ useHold, p });
+            bool ok = search(state, height - lines);
+            path.pop_back();
+            journal.undo(state);
+
+            if (ok) {
+                found = true;
+                if (!config.findAll || static_cast<int>(result->solutions.size()) >= config.maxSolutions) return true;
+            }
+            if (result->timedOut) return found;
+        }
+    }
+
+    if (!found && !result->timedOut) failed.insert(key);
+    return found;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "Board.hpp"
+#include "GameCore.hpp"
+#include "MoveGen.hpp"
+#include "SearchState.hpp"
+#include <cstdint>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+// PerfectClearSolver について
+// 低い積み（2〜4段）から、現在のピース・Hold・Next を使って盤面を完全に空にする並び（パーフェクトクリア）を探す
+// 下から lines 段を「埋める領域」とし、各ピースはその領域の中にだけ置く（ラインが消えたら領域も縮む）
+//   枝刈り: 領域の空きマス数は4の倍数でなければならず（そうでない lines は最初から試さない）、
+//           残りの空きマス / 4 が残りのピース数を超えたら打ち切る
+//           上から下まで埋まった列で区切られた左右の空きマスも、それぞれ4の倍数でなければならない
+//   メモ化: 解がないと分かった局面（盤面・現在のピース・Hold・Nextの位置・残りの段数）を覚えておき、
+//           別の順番で同じ局面に来たら探さない
+// 探索は SearchState を SearchJournal で進めて戻す深さ優先探索で、盤面はコピーしない
+
+// ==== 1手（Hold するかと、置く位置） ====
+struct PcStep {
+    bool useHold = false;
+    Placement placement{};
+};
+
+struct PcConfig {
+    int maxLines = 4;             // 試す段数の上限（2〜4）
+    int timeBudgetUs = 10000;     // 探索時間の上限（マイクロ秒、0 なら無制限）
+    bool findAll = false;         // true ならすべての解を集める（false なら最初の1つで止める）
+    int maxSolutions = 1000;      // findAll のときに集める解の上限
+    bool useHold = true;          // Hold を使う並びも探すか
+};
+
+struct PcResult {
+    bool found = false;
+    bool timedOut = false;                    // 時間切れで探し切れなかったか
+    int lines = 0;                            // 解の段数（見つかった中で一番少ない段数）
+    std::vector<PcStep> best;                 // 一番良い解（Hold の回数が一番少ないもの）
+    std::vector<std::vector<PcStep>> solutions; // findAll のときの全解（best と同じ段数のもの）
+    std::uint64_t nodes = 0;                  // 調べた局面の数
+};
+
+class PerfectClearSolver {
+public:
+    explicit PerfectClearSolver(const PcConfig& config = PcConfig());
+
+    // 盤面・現在のピース・Hold・Next からパーフェクトクリアを探す
+    PcResult solve(const BitBoard& board, PieceType current, std::optional<PieceType> hold,
+        const std::vector<PieceType>& queue);
+
+    // GameCore の今の局面から探す（このターンで Hold 済みなら最初の1手は Hold しない）
+    PcResult solve(const GameCore& core);
+
+    const PcConfig& getConfig() const { return config; }
+
+private:
+    PcConfig config;
+    MoveGenerator gen;
+    SearchJournal journal;
+    std::vector<std::vector<Placement>> buffers;   // 深さごと（Hold しない手 / する手）の配置
+    std::unordered_set<std::uint64_t> failed;      // 解がないと分かった局面
+    std::vector<PcStep> path;                      // 今たどっている並び
+
+    // 1回の solve() の間だけ使う
+    const std::vector<PieceType>* queue = nullptr;
+    PcResult* result = nullptr;
+    bool firstHoldAllowed = true;
+    std::int64_t deadlineUs = 0;
+
+    // height 段の領域を埋め切る並びを探す（見つかったら true）
+    bool search(SearchState& state, int height);
+    bool outOfTime();
+};
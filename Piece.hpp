@@ -1,10 +1,12 @@
 #pragma once 
 #include "Board.hpp" 
+#include "SrsTables.hpp"
 #include <SFML/Graphics.hpp> 
 #include <array> 
 #include <deque> 
 #include <random> 
 #include <optional>
+#include <cstdint>
 
 // 列挙型 (enum) = 限られた選択肢を名前付きで表す型
 //enum classとすることで、Tではなく、PieceType::Tと必ず型を指定して使うようになり、安全性が上がる
@@ -36,23 +38,11 @@ enum class PieceType { T, S, Z, I, O, L, J };
 enum class Rotation { Spawn = 0, Right = 1, Reverse = 2, Left = 3 };
 
 // ==== ピース形状と色の定義（実体は .cpp 側で定義） ====
-// それぞれのミノの4マス分の相対座標
+// それぞれのミノの4マス分の相対座標（回転後の形やキックは SrsTables.hpp の表を使う）
 extern const std::array<std::array<sf::Vector2i, 4>, 7> PIECE_SHAPES;
 // それぞれのミノの色
 extern const std::array<sf::Color, 7> PIECE_COLORS;
 
-// --- ウォールキックテーブル宣言 ---
-extern const std::array<std::array<sf::Vector2i, 5>, 4> JLSTZ_OFFSET_TABLE;
-extern const std::array<std::array<sf::Vector2i, 5>, 4> I_OFFSET_TABLE;
-extern const std::array<std::array<sf::Vector2i, 5>, 4> O_OFFSET_TABLE;
-// ==== ゲームの状態を表す構造体 ====
-struct GameState {
-    PieceType currentPiece;                 // 現在操作中のミノ
-    std::array<PieceType, 5> nextPieces;    // Nextに表示されている5つのミノ
-    bool holdExists;                        // Holdにミノがあるか
-    bool holdUsed;                          // このターンでHoldを使ったか
-};
-
 // ==== ピースを表すクラス ====
 class Piece {
 public:
@@ -63,20 +53,42 @@ public:
     int x = 3, y = 0;                        // フィールド上での位置（左下が基準）
 
     Piece(PieceType type);                   // コンストラクタ（種類を指定して生成）
-    void draw(sf::RenderWindow& window);     // フィールド上に描画
-    void drawPreview(sf::RenderWindow& window, int px, int py, int size = 20); // NextやHoldの小さな表示用
     std::array<sf::Vector2i, 4> getAbsolutePositions() const; //現在のブロックの座標を取得する
-    bool canMove(Board& board, int dx, int dy); // 指定方向に動けるか判定
+    // 盤面を受け取る判定は盤面の大きさごとのテンプレート（盤面の外はすべて壁として扱う）
+    template <int W, int H, int V>
+    bool canMove(const BasicBitBoard<W, H, V>& board, int dx, int dy) const { // 指定方向に動けるか判定
+        return !board.overlaps(mask(), x + dx, y + dy);
+    }
+    template <int W, int H, int V>
+    int dropDistance(const BasicBitBoard<W, H, V>& board) const { // 今の位置からまっすぐ何段落とせるか（ゴースト・ハードドロップ用）
+        return board.dropDistance(mask(), x, y);
+    }
     // 任意のブロック配列で判定する canMove としてオーバーロード
     //bool canMove(Board& board, const std::array<sf::Vector2i, 4>& testBlocks, int dx, int dy);
     void move(int dx, int dy);               // 実際に移動する
     std::array<sf::Vector2i, 4> getRotatedCells(int rotationState) const;
-    bool collides(Board& board, int xOffset, int yOffset, int rotationState) const;
-    // 右回転なら clockwise = true、左回転なら false
-    void rotate(Board& board, bool clockwise);
-    void place(Board& board);
+    // 回転状態 rotationState で (xOffset, yOffset) だけずらした位置が、壁・床・天井・ブロックと重なるか
+    template <int W, int H, int V>
+    bool collides(const BasicBitBoard<W, H, V>& board, int xOffset, int yOffset, int rotationState) const {
+        return board.overlaps(SRS_MASKS[static_cast<int>(type)][rotationState], x + xOffset, y + yOffset);
+    }
+    // 右回転なら clockwise = true、左回転なら false。回転できたら true を返す
+    // （実体は Piece.cpp で Board.hpp の盤面の大きさごとに作る）
+    template <int W, int H, int V>
+    bool rotate(const BasicBitBoard<W, H, V>& board, bool clockwise);
+    template <int W, int H, int V>
+    void place(BasicBoard<W, H, V>& board) const {
+        board.placeMask(mask(), x, y, color);
+    }
+
+private:
+    // 今の種類と回転状態の行マスク（blocks は常に SRS_CELLS[type][rotation] と同じ形）
+    const PieceMask& mask() const { return SRS_MASKS[static_cast<int>(type)][static_cast<int>(rotation)]; }
 };
 
+extern template bool Piece::rotate(const BitBoard& board, bool clockwise);
+extern template bool Piece::rotate(const BufferedBitBoard& board, bool clockwise);
+
 // ==== 7種1巡の「bag方式」を管理するクラス ====
 class Bag {
 private:
@@ -85,41 +97,20 @@ private:
     void shuffleBag();                       // 新しい7種をシャッフルして袋に補充
 public:
     Bag();                                   // コンストラクタ（乱数初期化）
+    explicit Bag(std::uint64_t seed);        // シードを指定（同じシードなら同じ順番になる）
     PieceType getNext();                     // 1つ取り出し、袋が空なら再補充
+    std::uint8_t remainingMask() const;      // 袋にまだ残っている種類（bit t が PieceType t、空なら 0）
 };
 
-// ==== ゲーム全体を管理するクラス ====
-class Game {
-private:
-    sf::RenderWindow window;                 // ゲームウィンドウ
-    Board board;                             // 盤面（フィールド）
-    Bag bag;                                 // 7種1巡の袋
-    Piece currentPiece;                      // 現在操作中のピース
-    std::deque<PieceType> nextQueue;         // Next表示用のキュー（複数個分）
-    std::optional<Piece> holdPiece;          // Holdに入っているピース
-    bool holdUsed = false, holdExists = false; // Holdを使ったかどうか、存在するか
-
-    sf::Clock fallClock, moveClock;          // 自動落下タイマー、横移動タイマー
-    float fallInterval = 500.5f;               // 自動落下の間隔（秒）
-    float moveInterval = 0.15f;              // 横移動の連続入力の間隔（秒）
-
-    PieceType holdPieceType;                 // Hold中のピースの種類
+// ==== 袋の残りの種類（bit t が PieceType t） ====
+// 次に出るピースは残っている種類から等確率で選ばれ、空になれば7種すべての新しい袋になる
+const std::uint8_t FULL_BAG = 0x7F;
 
-    sf::Font font;                           // GUI用フォント（スコアやNext表示に利用）
-
-public:
-    Game();                                  // コンストラクタ（初期化）
-    void run();                              // メインループ（イベント・更新・描画を回す）
-    GameState getGameState() const;          // 状態を取得する関数
-private:
-    void handleEvents();                     // イベント処理（閉じるボタンなど）
-    void handleInput();                      // 入力処理（移動・回転・Holdなど）
-    void handleFall();                       // 自動落下の処理
-    void render();                           // 描画処理（盤面・ピース・UI表示）
-};
-
-// ==== ウォールキックテーブル取得関数（宣言） ====
-inline const std::array<std::array<sf::Vector2i, 5>, 4>& getWallKickTable(PieceType type);
+// 袋 bag から t を引いたあとの袋（最後の1つなら次の新しい袋）
+inline std::uint8_t bagAfterDraw(std::uint8_t bag, PieceType t) {
+    bag = static_cast<std::uint8_t>(bag & ~(1u << static_cast<int>(t)));
+    return bag == 0 ? FULL_BAG : bag;
+}
 
 inline std::string pieceTypeToString(PieceType type) {
     switch (type) {
@@ -0,0 +1,85 @@
+#include "Renderer.hpp"
+
+namespace {
+    const sf::Color EMPTY_COLOR(30, 30, 30);   // 空きマスは濃いグレー
+}
+
+// ==================== BoardRenderer クラス ====================
+// 盤面の四角形の位置はここで1度だけ決める
+BoardRenderer::BoardRenderer(sf::Vector2f origin, int cellSize)
+    : origin(origin), cellSize(cellSize), stack(sf::Quads), pieces(sf::Quads)
+{
+    for (int y = 0; y < Board::HEIGHT; ++y)
+        for (int x = 0; x < Board::WIDTH; ++x)
+            appendCell(stack, origin.x + x * cellSize, origin.y + y * cellSize,
+                static_cast<float>(cellSize), EMPTY_COLOR);
+}
+
+void BoardRenderer::appendCell(sf::VertexArray& array, float px, float py, float size, sf::Color color) {
+    float s = size - 1;
+    array.append(sf::Vertex(sf::Vector2f(px, py), color));
+    array.append(sf::Vertex(sf::Vector2f(px + s, py), color));
+    array.append(sf::Vertex(sf::Vector2f(px + s, py + s), color));
+    array.append(sf::Vertex(sf::Vector2f(px, py + s), color));
+}
+
+void BoardRenderer::appendPiece(sf::VertexArray& array, const std::array<CellOffset, 4>& cells,
+    float px, float py, float size, sf::Color color) {
+    for (const auto& c : cells) appendCell(array, px + c.x * size, py + c.y * size, size, color);
+}
+
+// 盤面が変わっていれば各マスの色を塗り直す
+void BoardRenderer::refreshStack(const Board& board) {
+    if (cachedBoard == &board && cachedRevision == board.revision && cachedHash == board.hash) return;
+    cachedBoard = &board;
+    cachedRevision = board.revision;
+    cachedHash = board.hash;
+
+    for (int y = 0; y < Board::HEIGHT; ++y) {
+        for (int x = 0; x < Board::WIDTH; ++x) {
+            sf::Color color = board.isOccupied(x, y) ? board.colorAt(x, y) : EMPTY_COLOR;
+            sf::Vertex* quad = &stack[(y * Board::WIDTH + x) * 4];
+            for (int i = 0; i < 4; ++i) quad[i].color = color;
+        }
+    }
+}
+
+void BoardRenderer::drawBoard(sf::RenderTarget& target, const Board& board) {
+    refreshStack(board);
+    target.draw(stack);
+}
+
+void BoardRenderer::draw(sf::RenderTarget& target, const GameCore& core) {
+    drawBoard(target, core.getBoard());
+
+    float size = static_cast<float>(cellSize);
+    float preview = size / 2;
+    pieces.clear();
+
+    // --- ゴースト（ハードドロップしたときに落ちる位置）と操作中のピース ---
+    const Piece& current = core.getCurrentPiece();
+    const auto& cells = SRS_CELLS[static_cast<int>(current.type)][static_cast<int>(current.rotation)];
+    int ghostY = current.y + current.dropDistance(core.getBoard());
+    sf::Color ghost = current.color;
+    ghost.a = 80;
+    appendPiece(pieces, cells, origin.x + current.x * size, origin.y + ghostY * size, size, ghost);
+    appendPiece(pieces, cells, origin.x + current.x * size, origin.y + current.y * size, size, current.color);
+
+    // --- Next5の表示 ---
+    float px = origin.x + Board::WIDTH * size + preview;
+    int i = 0;
+    for (PieceType type : core.getNextQueue()) {
+        appendPiece(pieces, SRS_CELLS[static_cast<int>(type)][0],
+            px, origin.y + preview + i * size * 2.5f, preview, PIECE_COLORS[static_cast<int>(type)]);
+        ++i;
+    }
+
+    // --- Holdの表示 ---
+    if (core.getHoldPiece()) {
+        PieceType type = core.getHoldPiece()->type;
+        appendPiece(pieces, SRS_CELLS[static_cast<int>(type)][0],
+            px, origin.y + size * 15, preview, PIECE_COLORS[static_cast<int>(type)]);
+    }
+
+    target.draw(pieces);
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include "Board.hpp"
+#include "GameCore.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdint>
+
+// BoardRenderer について
+// 1マスごとに sf::RectangleShape を作って window.draw するのではなく、
+// マスを四角形（4頂点）として sf::VertexArray にまとめ、1回の draw で描く
+//   固定済みの盤面: 頂点の位置は最初に1度だけ作り、盤面が変わったとき（Board::revision が進んだとき）だけ色を塗り直す
+//   操作中のピース・ゴースト・Next・Hold: 毎フレーム 32 マス分の頂点を詰め直すだけ（Piece は作らない）
+// 1つの盤面は2回の draw で描けるので、観戦用に多数の盤面を並べても描画呼び出しが増えにくい
+// 盤面ごとにキャッシュを持つので、並べる場合は盤面の数だけ BoardRenderer を用意すること
+
+class BoardRenderer {
+public:
+    // origin = 盤面の左上の描画位置、cellSize = 盤面の1マスの大きさ（Next と Hold はその半分）
+    explicit BoardRenderer(sf::Vector2f origin = sf::Vector2f(0, 0), int cellSize = 40);
+
+    // 盤面・操作中のピースとゴースト・Next・Hold をまとめて描く
+    void draw(sf::RenderTarget& target, const GameCore& core);
+
+    // 固定済みの盤面だけを描く
+    void drawBoard(sf::RenderTarget& target, const Board& board);
+
+private:
+    sf::Vector2f origin;
+    int cellSize;
+
+    sf::VertexArray stack;                   // 盤面の全マス（WIDTH × HEIGHT 個の四角形）
+    sf::VertexArray pieces;                  // 操作中のピース・ゴースト・Next・Hold（毎フレーム詰め直す）
+
+    // stack に色を塗った盤面（アドレス・revision・hash が同じなら塗り直さない）
+    const Board* cachedBoard = nullptr;
+    std::uint32_t cachedRevision = 0;
+    std::uint64_t cachedHash = 0;
+
+    void refreshStack(const Board& board);
+    // 1マス分の四角形を追加する（枠に見えるよう 1px 小さくする）
+    static void appendCell(sf::VertexArray& array, float px, float py, float size, sf::Color color);
+    // ピースの4マスを追加する（cells は SRS_CELLS の1つ、(px, py) は原点の描画位置）
+    static void appendPiece(sf::VertexArray& array, const std::array<CellOffset, 4>& cells,
+        float px, float py, float size, sf::Color color);
+};
@@ -0,0 +1,196 @@
+#include "Replay.hpp"
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+    // リトルエンディアンで書く
+    template <typename T>
+    void writeLE(std::vector<std::uint8_t>& out, T value) {
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+            out.push_back(static_cast<std::uint8_t>(static_cast<std::uint64_t>(value) >> (8 * i)));
+    }
+
+    // 範囲を確かめながらリトルエンディアンで読む
+    struct Reader {
+        const std::uint8_t* data;
+        std::size_t size;
+        std::size_t pos = 0;
+
+        template <typename T>
+        bool read(T& value) {
+            if (size - pos < sizeof(T)) return false;
+            std::uint64_t v = 0;
+            for (std::size_t i = 0; i < sizeof(T); ++i) v |= static_cast<std::uint64_t>(data[pos + i]) << (8 * i);
+            value = static_cast<T>(v);
+            pos += sizeof(T);
+            return true;
+        }
+    };
+
+    bool sameSnapshot(const GameSnapshot& a, const GameSnapshot& b) {
+        return a.bagDraws == b.bagDraws && a.rows == b.rows && a.hold == b.hold && a.holdUsed == b.holdUsed;
+    }
+
+}
+
+// ==================== Replay クラス ====================
+// 1手を記録する（間隔ごとに置く前の局面をキーフレームとして残す）
+void Replay::record(const GameCore& core, bool hold, Rotation rotation, int x, int y) {
+    if (pieceCount() % keyframeInterval == 0) keyframes.push_back(core.snapshot());
+    events.push_back(encodeEvent(hold, rotation, x, y));
+}
+
+std::uint16_t Replay::encodeEvent(bool hold, Rotation rotation, int x, int y) {
+    return static_cast<std::uint16_t>(((x + 2) & 0xF) | (((y + 3) & 0x1F) << 4)
+        | (static_cast<int>(rotation) << 9) | ((hold ? 1 : 0) << 11));
+}
+
+void Replay::decodeEvent(std::uint16_t event, bool& hold, Rotation& rotation, int& x, int& y) {
+    x = (event & 0xF) - 2;
+    y = ((event >> 4) & 0x1F) - 3;
+    rotation = static_cast<Rotation>((event >> 9) & 3);
+    hold = ((event >> 11) & 1) != 0;
+}
+
+// バイト列に変換する
+std::vector<std::uint8_t> Replay::serialize() const {
+    std::vector<std::uint8_t> out;
+    out.reserve(24 + events.size() * 2 + keyframes.size() * (8 + Board::HEIGHT * 2));
+
+    for (char c : { 'T', 'R', 'P', 'L' }) out.push_back(static_cast<std::uint8_t>(c));
+    writeLE<std::uint8_t>(out, VERSION);
+    writeLE<std::uint8_t>(out, 0);
+    writeLE<std::uint16_t>(out, static_cast<std::uint16_t>(keyframeInterval));
+    writeLE<std::uint64_t>(out, seed);
+
+    writeLE<std::uint32_t>(out, static_cast<std::uint32_t>(events.size()));
+    for (std::uint16_t e : events) writeLE<std::uint16_t>(out, e);
+
+    writeLE<std::uint32_t>(out, static_cast<std::uint32_t>(keyframes.size()));
+    for (const auto& k : keyframes) {
+        writeLE<std::uint32_t>(out, k.bagDraws);
+        writeLE<std::int8_t>(out, static_cast<std::int8_t>(k.hold));
+        writeLE<std::uint8_t>(out, k.holdUsed ? 1 : 0);
+        // 上の空行は数だけ書く
+        int top = 0;
+        while (top < Board::HEIGHT && k.rows[top] == 0) ++top;
+        writeLE<std::uint8_t>(out, static_cast<std::uint8_t>(top));
+        for (int y = top; y < Board::HEIGHT; ++y) writeLE<std::uint16_t>(out, k.rows[y]);
+    }
+    return out;
+}
+
+// バイト列から読み込む
+bool Replay::deserialize(const std::uint8_t* data, std::size_t size) {
+    Reader in{ data, size };
+    if (size < 4 || data[0] != 'T' || data[1] != 'R' || data[2] != 'P' || data[3] != 'L') return false;
+    in.pos = 4;
+
+    std::uint8_t version, reserved;
+    std::uint16_t interval;
+    std::uint32_t eventCount, keyframeCount;
+    if (!in.read(version) || version != VERSION || !in.read(reserved)) return false;
+    if (!in.read(interval) || interval == 0 || !in.read(seed)) return false;
+    keyframeInterval = interval;
+
+    if (!in.read(eventCount) || (size - in.pos) / 2 < eventCount) return false;
+    events.resize(eventCount);
+    for (auto& e : events) in.read(e);
+
+    // キーフレーム k は k * keyframeInterval 手目を置く直前なので、手の数より多くはない
+    if (!in.read(keyframeCount) || keyframeCount > (static_cast<std::uint64_t>(eventCount) + interval - 1) / interval)
+        return false;
+    keyframes.assign(keyframeCount, GameSnapshot());
+    for (std::size_t i = 0; i < keyframes.size(); ++i) {
+        GameSnapshot& k = keyframes[i];
+        std::int8_t hold;
+        std::uint8_t holdUsed, top;
+        if (!in.read(k.bagDraws) || !in.read(hold) || !in.read(holdUsed) || !in.read(top)) return false;
+        if (top > Board::HEIGHT || hold < -1 || hold >= 7) return false;
+        // Bag から引いた数は、最初の6個 + 置いたピースの数 + 初めて Hold したときの1個
+        std::uint64_t firstDraws = GameCore::NEXT_COUNT + 1 + static_cast<std::uint64_t>(i) * interval;
+        if (k.bagDraws != firstDraws + (hold >= 0 ? 1 : 0)) return false;
+        k.seed = seed;
+        k.hold = hold;
+        k.holdUsed = holdUsed != 0;
+        for (int y = top; y < Board::HEIGHT; ++y)
+            if (!in.read(k.rows[y])) return false;
+    }
+    return true;
+}
+
+bool Replay::save(const std::string& path) const {
+    std::vector<std::uint8_t> bytes = serialize();
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+bool Replay::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return false;
+    std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return deserialize(bytes.data(), bytes.size());
+}
+
+// ==================== ReplayPlayer クラス ====================
+ReplayPlayer::ReplayPlayer(const Replay& replay)
+    : replay(replay), core(std::make_unique<GameCore>(replay.seed))
+{
+}
+
+// piece 手目を置く直前へ移動する
+bool ReplayPlayer::seek(int piece) {
+    if (piece < 0 || piece > replay.pieceCount()) return false;
+
+    // 戻る場合や、キーフレームをまたいで進む場合はキーフレームから始める
+    int k = piece / replay.keyframeInterval;
+    if (k >= static_cast<int>(replay.keyframes.size())) k = static_cast<int>(replay.keyframes.size()) - 1;
+    int keyPos = k * replay.keyframeInterval;
+    if (k >= 0 && (piece < pos || keyPos > pos)) {
+        core = std::make_unique<GameCore>(replay.keyframes[k]);
+        pos = keyPos;
+    }
+    else if (piece < pos) {
+        core = std::make_unique<GameCore>(replay.seed);
+        pos = 0;
+    }
+
+    while (pos < piece)
+        if (!next()) return false;
+    return true;
+}
+
+// 記録された1手を進める
+bool ReplayPlayer::next() {
+    if (finished()) return false;
+
+    bool hold;
+    Rotation rotation;
+    int x, y;
+    Replay::decodeEvent(replay.events[pos], hold, rotation, x, y);
+    if (hold && !core->step(Action::Hold).moved) return false;
+    if (!core->placeAt(rotation, x, y).locked) return false;
+    ++pos;
+    return true;
+}
+
+// 最初から再生して、すべての手とキーフレームを確かめる
+int verifyReplay(const Replay& replay) {
+    GameCore core(replay.seed);
+    for (int i = 0; i < replay.pieceCount(); ++i) {
+        if (i % replay.keyframeInterval == 0) {
+            std::size_t k = i / replay.keyframeInterval;
+            if (k >= replay.keyframes.size() || !sameSnapshot(core.snapshot(), replay.keyframes[k])) return i;
+        }
+
+        bool hold;
+        Rotation rotation;
+        int x, y;
+        Replay::decodeEvent(replay.events[i], hold, rotation, x, y);
+        if (hold && !core.step(Action::Hold).moved) return i;
+        if (!core.placeAt(rotation, x, y).locked) return i;
+    }
+    return -1;
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include "GameCore.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// リプレイ形式について
+// シード付きの1局を「シード + 1手ごとの配置（16bit）」で記録する
+// ピースの並びはシードから再現できるので、置いた位置と Hold したかだけを持てばよい
+// さらに keyframeInterval 手ごとに局面のスナップショット（盤面・Hold・Bag から引いた数）を持ち、
+// N 手目へ移動するときは直前のキーフレームから再生すれば済むようにする
+//
+// ファイルの中身（数値はすべてリトルエンディアン）:
+//   "TRPL" / version(u8) / reserved(u8) / keyframeInterval(u16) / seed(u64)
+//   eventCount(u32) / events(u16 × eventCount)
+//   keyframeCount(u32) / keyframes × keyframeCount
+//     keyframe = bagDraws(u32) / hold(i8) / holdUsed(u8) / 上の空行の数(u8) / 残りの行(u16 × 行数)
+//
+// 1手（event）のビット配置: bit 0-3 = x + 2, bit 4-8 = y + 3, bit 9-10 = 回転状態, bit 11 = 先に Hold したか
+
+class Replay {
+public:
+    static const int VERSION = 1;
+
+    std::uint64_t seed = 0;
+    int keyframeInterval = 64;                // キーフレームの間隔（手数）
+    std::vector<std::uint16_t> events;        // 1手ごとの配置
+    std::vector<GameSnapshot> keyframes;      // keyframes[k] = k * keyframeInterval 手目を置く直前の局面
+
+    Replay() {}
+    explicit Replay(std::uint64_t seed, int keyframeInterval = 64) : seed(seed), keyframeInterval(keyframeInterval) {}
+
+    // 1手を記録する（core は Hold する前・置く前の状態）
+    void record(const GameCore& core, bool hold, Rotation rotation, int x, int y);
+
+    int pieceCount() const { return static_cast<int>(events.size()); }
+
+    static std::uint16_t encodeEvent(bool hold, Rotation rotation, int x, int y);
+    static void decodeEvent(std::uint16_t event, bool& hold, Rotation& rotation, int& x, int& y);
+
+    // バイト列との相互変換（読めない・壊れている場合は false）
+    std::vector<std::uint8_t> serialize() const;
+    bool deserialize(const std::uint8_t* data, std::size_t size);
+
+    bool save(const std::string& path) const;
+    bool load(const std::string& path);
+};
+
+// ==== リプレイの再生（ヘッドレス） ====
+class ReplayPlayer {
+public:
+    explicit ReplayPlayer(const Replay& replay);
+
+    // piece 手目を置く直前の局面へ移動する（直前のキーフレームから再生する）
+    bool seek(int piece);
+
+    // 1手進める（記録された手が置けなければ false）
+    bool next();
+
+    int position() const { return pos; }
+    bool finished() const { return pos >= replay.pieceCount(); }
+    const GameCore& getCore() const { return *core; }
+
+private:
+    const Replay& replay;
+    std::unique_ptr<GameCore> core;
+    int pos = 0;
+};
+
+// 最初から最後まで再生し、すべての手が置けてキーフレームとも一致するか確かめる
+// 問題がなければ -1、あれば最初に食い違った手番号を返す
+int verifyReplay(const Replay& replay);
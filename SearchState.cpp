@@ -0,0 +1,93 @@
+#include "SearchState.hpp"
+#include <algorithm>
+
+SearchState makeSearchState(const GameCore& core, std::vector<PieceType>& queue) {
+    SearchState s;
+    s.board = core.getBoard();
+    s.current = static_cast<std::int8_t>(core.getCurrentPiece().type);
+    s.hold = core.getHoldPiece() ? static_cast<std::int8_t>(core.getHoldPiece()->type) : -1;
+    s.cursor = 0;
+    queue.assign(core.getNextQueue().begin(), core.getNextQueue().end());
+    return s;
+}
+
+// ==================== SearchJournal クラス ====================
+SearchJournal::SearchJournal(int maxDepth) {
+    entries.reserve(maxDepth);
+    savedRows.reserve(static_cast<std::size_t>(maxDepth) * BitBoard::HEIGHT);
+}
+
+int SearchJournal::apply(SearchState& state, const std::vector<PieceType>& queue, bool useHold, const Placement& placement) {
+    // --- Hold したあとのピースの並びを決める ---
+    int piece = state.current, hold = state.hold, cursor = state.cursor;
+    if (piece < 0) return -1;
+    if (useHold) {
+        if (hold >= 0) {
+            std::swap(piece, hold);
+        }
+        else {
+            if (cursor >= static_cast<int>(queue.size())) return -1;
+            hold = piece;
+            piece = static_cast<int>(queue[cursor++]);
+        }
+    }
+    if (piece != static_cast<int>(placement.type)) return -1;
+
+    // --- 変わる行を保存する ---
+    // ラインが揃わなければピースの行だけ、揃うなら積まれている一番上からピースの一番下までが変わる
+    const PieceMask& m = SRS_MASKS[piece][static_cast<int>(placement.rotation)];
+    BitBoard& b = state.board;
+    int left = placement.x + m.minX;
+    int pieceTop = placement.y + m.minY;
+    int first = std::max(pieceTop, 0), last = std::min(pieceTop + m.height, BitBoard::HEIGHT) - 1;
+    bool clears = false;
+    for (int y = first; y <= last; ++y)
+        if ((b.rows[y] | ((m.mask[y - pieceTop] << left) & BitBoard::FULL_ROW)) == BitBoard::FULL_ROW) clears = true;
+    if (clears) {
+        int stackTop = BitBoard::HEIGHT;
+        for (int x = 0; x < BitBoard::WIDTH; ++x) stackTop = std::min(stackTop, BitBoard::HEIGHT - b.heights[x]);
+        first = std::min(first, stackTop);
+    }
+
+    Entry e;
+    e.hash = b.hash;
+    e.heights = b.heights;
+    e.aggregateHeight = static_cast<std::int16_t>(b.aggregateHeight);
+    e.cellCount = static_cast<std::int16_t>(b.cellCount);
+    e.current = state.current;
+    e.hold = state.hold;
+    e.cursor = state.cursor;
+    e.firstRow = static_cast<std::int8_t>(first);
+    e.rowCount = static_cast<std::int8_t>(std::max(last - first + 1, 0));
+    e.rowOffset = static_cast<std::uint32_t>(savedRows.size());
+    savedRows.insert(savedRows.end(), b.rows.begin() + first, b.rows.begin() + first + e.rowCount);
+    entries.push_back(e);
+
+    // --- 置いて次のピースを出す ---
+    int lines = applyPlacement(b, placement);
+    state.hold = static_cast<std::int8_t>(hold);
+    if (cursor < static_cast<int>(queue.size())) {
+        state.current = static_cast<std::int8_t>(queue[cursor]);
+        state.cursor = static_cast<std::uint8_t>(cursor + 1);
+    }
+    else {
+        state.current = -1;
+        state.cursor = static_cast<std::uint8_t>(cursor);
+    }
+    return lines;
+}
+
+void SearchJournal::undo(SearchState& state) {
+    const Entry& e = entries.back();
+    BitBoard& b = state.board;
+    std::copy_n(savedRows.begin() + e.rowOffset, e.rowCount, b.rows.begin() + e.firstRow);
+    b.hash = e.hash;
+    b.heights = e.heights;
+    b.aggregateHeight = e.aggregateHeight;
+    b.cellCount = e.cellCount;
+    state.current = e.current;
+    state.hold = e.hold;
+    state.cursor = e.cursor;
+    savedRows.resize(e.rowOffset);
+    entries.pop_back();
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "Board.hpp"
+#include "GameCore.hpp"
+#include "MoveGen.hpp"
+#include "Piece.hpp"
+#include "Zobrist.hpp"
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// SearchState について
+// 探索で1手ずつ進めたり戻したりするための、固定サイズでそのままコピーできる局面
+// 盤面は BitBoard（色を持たない）、ピースは種類の番号だけを持ち、Next は外に置いた列 queue の添字で表す
+// GameCore の Piece や std::optional<Piece>、色つきの Board はここには入らない
+//
+// SearchJournal は apply() で変えた分（盤面の変わった行・ハッシュ・列の高さ・ピースの状態）だけを記録し、
+// undo() で逆順に戻す。記録用の配列は使い回すので、深さ優先探索で進めて戻しても確保は起きない
+
+struct SearchState {
+    BitBoard board;
+    std::int8_t current = -1;     // 操作中のピース（PieceType、-1 ならもう置くピースがない）
+    std::int8_t hold = -1;        // Hold 中のピース（-1 なら空）
+    std::uint8_t cursor = 0;      // 次に出てくるピースの queue の添字
+
+    // 置換表に使うハッシュ（盤面・現在のピース・Hold・Nextの位置）
+    std::uint64_t key() const {
+        return searchStateHash(board.hash, current < 0 ? 0 : current, hold, cursor);
+    }
+};
+
+static_assert(std::is_trivially_copyable<SearchState>::value, "SearchState is cloned by plain copies");
+
+// GameCore の今の局面を SearchState にする（queue には Next の列が入り、cursor は 0）
+SearchState makeSearchState(const GameCore& core, std::vector<PieceType>& queue);
+
+class SearchJournal {
+public:
+    // maxDepth 手ぶんの記録を先に確保しておく（超えても動くが、そのときは確保が起きる）
+    explicit SearchJournal(int maxDepth = 32);
+
+    // 1手進める：useHold なら先に Hold し、current を placement に置いてライン消去し、queue から次を出す
+    // placement.type が Hold 後の current と違う、置くピースがない、Hold できない場合は何もせず -1
+    // 成功したら消したライン数を返す
+    int apply(SearchState& state, const std::vector<PieceType>& queue, bool useHold, const Placement& placement);
+
+    // 最後の apply() を取り消す
+    void undo(SearchState& state);
+
+    int depth() const { return static_cast<int>(entries.size()); }
+    void clear() { entries.clear(); savedRows.clear(); }
+
+private:
+    // 1手ぶんの記録
+    struct Entry {
+        std::uint64_t hash;
+        std::array<std::uint8_t, BitBoard::WIDTH> heights;
+        std::int16_t aggregateHeight, cellCount;
+        std::int8_t current, hold;
+        std::uint8_t cursor;
+        std::int8_t firstRow;         // savedRows に保存した行の範囲
+        std::int8_t rowCount;
+        std::uint32_t rowOffset;      // savedRows の中の位置
+    };
+
+    std::vector<Entry> entries;
+    std::vector<BitBoard::Row> savedRows;
+};
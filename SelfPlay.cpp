@@ -0,0 +1,114 @@
+#include "SelfPlay.hpp"
+#include "Zobrist.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// 局番号からシードを作る（隣の番号でも乱数列が似ないよう混ぜる）
+std::uint64_t gameSeed(std::uint64_t baseSeed, int index) {
+    return zobristMix(baseSeed ^ (static_cast<std::uint64_t>(index) * 0x9E3779B97F4A7C15ull));
+}
+
+// 1局を最後まで遊ぶ
+GameOutcome playGame(BeamSearchBot& bot, std::uint64_t seed, int maxPieces, bool record, bool recordSamples) {
+    auto start = std::chrono::steady_clock::now();
+    GameOutcome outcome;
+    outcome.seed = seed;
+
+    GameCore core(seed, false);   // 描画しないので盤面の色は持たない
+    if (record) outcome.replay = Replay(seed);
+    while (!core.isGameOver() && (maxPieces <= 0 || outcome.pieces < maxPieces)) {
+        BotDecision decision = bot.decide(core);
+        if (!decision.found) break;
+        if (record) {
+            const Placement& p = decision.placement;
+            outcome.replay.record(core, decision.useHold, p.rotation, p.x, p.y);
+        }
+        if (recordSamples) outcome.samples.push_back(makeDatasetRecord(core, decision.useHold, decision.placement));
+
+        // ボットの操作列を人間の入力と同じく1つずつ step に渡す
+        for (Action action : decision.inputs) {
+            StepResult result = core.step(action);
+            if (result.locked) {
+                ++outcome.pieces;
+                outcome.lines += result.linesCleared;
+                if (recordSamples) outcome.samples.back().linesCleared = static_cast<std::uint8_t>(result.linesCleared);
+            }
+        }
+    }
+
+    outcome.toppedOut = core.isGameOver();
+    if (recordSamples) finishDatasetRecords(outcome.samples, outcome.toppedOut);
+    outcome.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return outcome;
+}
+
+// N 局を並列に遊ぶ（空いたワーカーが次の局番号を取っていく）
+SelfPlayReport runSelfPlay(const SelfPlayConfig& config, const GameSink& sink) {
+    SelfPlayReport report;
+    report.games.resize(std::max(config.games, 0));
+
+    int threads = config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(1, std::min(threads, static_cast<int>(report.games.size())));
+
+    // 結果を再現できるよう、局ごとのボットは1スレッド・時間無制限にする
+    BotConfig botConfig = config.bot;
+    botConfig.threads = 1;
+    botConfig.timeBudgetUs = 0;
+
+    const int games = static_cast<int>(report.games.size());
+    const int window = SINK_WINDOW_PER_THREAD * threads;
+    std::mutex mutex;
+    std::condition_variable emitted;   // nextToEmit が進んだ
+    int nextGame = 0;                  // 次に始める局
+    int nextToEmit = 0;                // 次に sink へ渡す局
+    std::vector<char> finished(games, 0);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int w = 0; w < threads; ++w) {
+        workers.emplace_back([&] {
+            BeamSearchBot bot(botConfig);
+            for (;;) {
+                int i;
+                {
+                    // sink に渡していない局が window 局たまっていたら、前の局が終わるのを待つ
+                    std::unique_lock<std::mutex> lock(mutex);
+                    if (sink) emitted.wait(lock, [&] { return nextGame >= games || nextGame < nextToEmit + window; });
+                    if (nextGame >= games) return;
+                    i = nextGame++;
+                }
+
+                GameOutcome outcome = playGame(bot, gameSeed(config.baseSeed, i), config.maxPieces,
+                    config.recordReplays, config.recordSamples);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                report.games[i] = std::move(outcome);
+                if (!sink) continue;
+
+                // 前の局がすべて終わっていれば、続いて終わっている局までまとめて渡す
+                finished[i] = 1;
+                bool advanced = false;
+                while (nextToEmit < games && finished[nextToEmit]) {
+                    GameOutcome& g = report.games[nextToEmit];
+                    sink(nextToEmit, g);
+                    g.samples = std::vector<DatasetRecord>();
+                    g.replay = Replay();
+                    ++nextToEmit;
+                    advanced = true;
+                }
+                if (advanced) emitted.notify_all();
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+    report.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const auto& g : report.games) {
+        report.totalPieces += g.pieces;
+        report.totalLines += g.lines;
+    }
+    return report;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "Bot.hpp"
+#include "Dataset.hpp"
+#include "GameCore.hpp"
+#include "Replay.hpp"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// 自己対戦（セルフプレイ）ランナーについて
+// ボットにヘッドレスの GameCore を N 局遊ばせ、ワーカースレッド1本につき1局ずつ並列に進める
+// 各局のシードは baseSeed と局番号から決まり、結果は局番号の順に並ぶので、
+// スレッド数や実行順に関係なく同じ設定なら同じ結果になる
+// （そのためボットの思考時間の上限は使わず、beamWidth と maxDepth だけで探索量を決める）
+//
+// 記録（samples / replay）は1局ごとに GameSink へ局番号の順に渡し、渡したあとは捨てる
+// 先に終わった局は前の局が終わるまで取っておくが、まだ渡していない一番前の局から
+// SINK_WINDOW_PER_THREAD × スレッド数 局より先には進まないので、手元に残る局の数には上限がある
+
+struct SelfPlayConfig {
+    int games = 8;                 // 遊ぶ局数
+    int threads = 0;               // ワーカー数（0 ならハードウェアのスレッド数）
+    std::uint64_t baseSeed = 1;    // 局 i のシードは gameSeed(baseSeed, i)
+    int maxPieces = 1000;          // 1局で置くピースの上限（0 なら無制限）
+    BotConfig bot;                 // 各局のボット設定（threads と timeBudgetUs は無視される）
+    bool recordReplays = false;    // 各局のリプレイを GameOutcome::replay に残すか
+    bool recordSamples = false;    // 各局の局面と選んだ手を GameOutcome::samples に残すか
+};
+
+// 1局分の結果
+struct GameOutcome {
+    std::uint64_t seed = 0;
+    int pieces = 0;                // 置いたピースの数
+    int lines = 0;                 // 消したライン数
+    bool toppedOut = false;        // 出現位置が埋まって終わったか（false なら上限まで生き残った）
+    double seconds = 0.0;          // この局にかかった時間
+    Replay replay;                 // recordReplays のときだけ中身が入る
+    std::vector<DatasetRecord> samples; // recordSamples のときだけ、1手に1件入る
+};
+
+// 終わった局を局番号の順に受け取る（呼ばれるのは1度に1スレッドだけ）
+using GameSink = std::function<void(int index, const GameOutcome& game)>;
+const int SINK_WINDOW_PER_THREAD = 2;
+
+// 全体の結果
+struct SelfPlayReport {
+    std::vector<GameOutcome> games;
+    double seconds = 0.0;          // 全体の経過時間
+    long long totalPieces = 0;
+    long long totalLines = 0;
+
+    double piecesPerSecond() const { return seconds > 0 ? totalPieces / seconds : 0.0; }
+    double gamesPerSecond() const { return seconds > 0 ? games.size() / seconds : 0.0; }
+};
+
+// 局番号 index のシード
+std::uint64_t gameSeed(std::uint64_t baseSeed, int index);
+
+// 1局を最後まで遊ぶ（bot は呼び出し元が用意する。record なら outcome.replay に、
+// recordSamples なら outcome.samples に記録する）
+GameOutcome playGame(BeamSearchBot& bot, std::uint64_t seed, int maxPieces, bool record = false, bool recordSamples = false);
+
+// N 局を並列に遊ぶ
+// sink を渡すと、各局を局番号の順に sink へ渡し、そのあと report 側の samples と replay は空にする
+SelfPlayReport runSelfPlay(const SelfPlayConfig& config, const GameSink& sink = nullptr);
@@ -0,0 +1,150 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+// SRS（スーパーローテーションシステム）の表をすべてコンパイル時に計算しておくヘッダー
+// 回転後のセル座標・行ごとのビットマスク・ウォールキックの移動量を
+// PieceType（T, S, Z, I, O, L, J の順）× 回転状態（Spawn, Right, Reverse, Left）で引けるようにする
+// これにより Piece::collides / Piece::rotate は表を引くだけで、回転の計算をしない
+
+// constexpr で扱える2次元の整数座標（sf::Vector2i は constexpr にできないため）
+struct CellOffset {
+    int x, y;
+};
+
+// ==== 各ピースの基本形状（Spawn 状態、y は下向きが正、並びは PieceType と同じ） ====
+constexpr std::array<std::array<CellOffset, 4>, 7> SRS_BASE_SHAPES = { {
+    {{ {-1,0}, {0,1}, {0,0}, {1,0} }},   // T
+    {{ {-1,1}, {0,1}, {0,0}, {1,0} }},   // S
+    {{ {-1,0}, {0,1}, {0,0}, {1,1} }},   // Z
+    {{ {-1,0}, {0,0}, {1,0}, {2,0} }},   // I
+    {{ {0,1}, {0,0}, {1,1}, {1,0} }},    // O
+    {{ {-1,1}, {-1,0}, {0,0}, {1,0} }},  // L
+    {{ {-1,0}, {0,0}, {1,1}, {1,0} }}    // J
+} };
+
+// // ------------------- ウォールキックテーブル（オフセット方式） -------------------
+// T, J, L, S, Z 用
+constexpr std::array<std::array<CellOffset, 5>, 4> JLSTZ_OFFSET_TABLE = { {
+    {{ {0,0}, {0,0}, {0,0}, {0,0}, {0,0} }},
+    {{ {0,0}, {1,0}, {1,1}, {0,-2}, {1,-2} }},
+    {{ {0,0}, {0,0}, {0,0}, {0,0}, {0,0} }},
+    {{ {0,0}, {-1,0}, {-1,1}, {0,-2}, {-1,-2} }}
+} };
+// I 用
+constexpr std::array<std::array<CellOffset, 5>, 4> I_OFFSET_TABLE = { {
+    {{ {0,0}, {-1,0}, {2,0}, {-1,0}, {2,0} }},
+    {{ {-1,0}, {0,0}, {0,0}, {0,-1}, {0,2} }},
+    {{ {-1,-1}, {1,-1}, {-2,-1}, {1,0}, {-2,0} }},
+    {{ {0,-1}, {0,-1}, {0,-1}, {0,1}, {0,-2} }},
+} };
+// O 用
+constexpr std::array<std::array<CellOffset, 5>, 4> O_OFFSET_TABLE = { {
+    {{ {0,0}, {0,0}, {0,0}, {0,0}, {0,0} }},
+    {{ {0,-1},{0,0}, {0,0}, {0,0}, {0,0} }},
+    {{ {-1,-1}, {0,0}, {0,0}, {0,0}, {0,0} }},
+    {{ {-1,0},{0,0}, {0,0}, {0,0}, {0,0} }}
+} };
+
+// ==== 回転後のセル座標 ====
+// (x, y) → (y, -x) を rotation 回繰り返す（Piece::rotate の clockwise = true 方向）
+constexpr CellOffset srsRotateCell(CellOffset c, int rotation) {
+    for (int i = 0; i < rotation; i++) {
+        int tmp = c.x;
+        c.x = c.y;
+        c.y = -tmp;
+    }
+    return c;
+}
+
+constexpr std::array<std::array<std::array<CellOffset, 4>, 4>, 7> makeSrsCells() {
+    std::array<std::array<std::array<CellOffset, 4>, 4>, 7> cells{};
+    for (int t = 0; t < 7; t++)
+        for (int r = 0; r < 4; r++)
+            for (int i = 0; i < 4; i++)
+                cells[t][r][i] = srsRotateCell(SRS_BASE_SHAPES[t][i], r);
+    return cells;
+}
+
+// SRS_CELLS[種類][回転状態] = ピース原点からの4マスの相対座標
+constexpr auto SRS_CELLS = makeSrsCells();
+
+// ==== 行ごとのビットマスク ====
+// ピースを包む矩形の左上 (minX, minY) からの相対で、1行を1ワードのビット列にしたもの
+// (x, y) に置いたとき、盤面の行 y + minY + i と mask[i] << (x + minX) が重なれば衝突
+struct PieceMask {
+    int minX, minY;                     // 原点から見た矩形の左上
+    int width, height;                  // 矩形の幅と高さ（行数）
+    std::array<std::uint16_t, 4> mask;  // 各行の占有ビット（bit 0 が矩形の左端）
+    std::array<std::int8_t, 4> bottom;  // 各列（矩形の左端から j 列目）の一番下のマスの行（mask の添字）
+};
+
+constexpr PieceMask makePieceMask(const std::array<CellOffset, 4>& cells) {
+    PieceMask m{ cells[0].x, cells[0].y, 0, 0, {}, {} };
+    int maxX = cells[0].x, maxY = cells[0].y;
+    for (const auto& c : cells) {
+        if (c.x < m.minX) m.minX = c.x;
+        if (c.y < m.minY) m.minY = c.y;
+        if (c.x > maxX) maxX = c.x;
+        if (c.y > maxY) maxY = c.y;
+    }
+    m.width = maxX - m.minX + 1;
+    m.height = maxY - m.minY + 1;
+    for (const auto& c : cells) {
+        m.mask[c.y - m.minY] |= static_cast<std::uint16_t>(1u << (c.x - m.minX));
+        if (c.y - m.minY > m.bottom[c.x - m.minX]) m.bottom[c.x - m.minX] = static_cast<std::int8_t>(c.y - m.minY);
+    }
+    return m;
+}
+
+constexpr std::array<std::array<PieceMask, 4>, 7> makeSrsMasks() {
+    std::array<std::array<PieceMask, 4>, 7> masks{};
+    for (int t = 0; t < 7; t++)
+        for (int r = 0; r < 4; r++)
+            masks[t][r] = makePieceMask(SRS_CELLS[t][r]);
+    return masks;
+}
+
+// SRS_MASKS[種類][回転状態]
+constexpr auto SRS_MASKS = makeSrsMasks();
+
+// ==== ウォールキックの移動量 ====
+// 回転前と回転後のオフセットの差（from - to）を試す順に並べたもの
+// 同じ移動量は同じ位置を試すだけなので、2回目以降は取り除いておく（O の後半など）
+struct KickList {
+    int count;                          // 有効な候補の数（1〜5）
+    std::array<CellOffset, 5> delta;    // 試す順の移動量
+};
+
+// 種類ごとのオフセット表（PieceType の並び: T, S, Z, I, O, L, J）
+constexpr const std::array<std::array<CellOffset, 5>, 4>& srsOffsetTable(int type) {
+    return type == 3 ? I_OFFSET_TABLE : type == 4 ? O_OFFSET_TABLE : JLSTZ_OFFSET_TABLE;
+}
+
+constexpr std::array<std::array<std::array<KickList, 2>, 4>, 7> makeSrsKicks() {
+    std::array<std::array<std::array<KickList, 2>, 4>, 7> kicks{};
+    for (int t = 0; t < 7; t++) {
+        const auto& table = srsOffsetTable(t);
+        for (int from = 0; from < 4; from++) {
+            for (int dir = 0; dir < 2; dir++) {
+                // dir = 0: clockwise = true（回転状態 +1）、dir = 1: clockwise = false（-1）
+                int to = (from + (dir == 0 ? 1 : 3)) % 4;
+                KickList& list = kicks[t][from][dir];
+                for (int i = 0; i < 5; i++) {
+                    CellOffset d{ table[from][i].x - table[to][i].x, table[from][i].y - table[to][i].y };
+                    bool seen = false;
+                    for (int j = 0; j < list.count; j++)
+                        if (list.delta[j].x == d.x && list.delta[j].y == d.y) seen = true;
+                    if (!seen) list.delta[list.count++] = d;
+                }
+            }
+        }
+    }
+    return kicks;
+}
+
+// SRS_KICKS[種類][回転前の状態][clockwise ? 0 : 1]
+constexpr auto SRS_KICKS = makeSrsKicks();
+
+static_assert(SRS_KICKS[4][0][0].count == 2, "Oミノは最初の候補と (0,0) の2つだけになる");
+static_assert(SRS_MASKS[3][0].width == 4 && SRS_MASKS[3][1].height == 4, "Iミノの矩形");
@@ -0,0 +1,154 @@
+#include "TetrisEnv.h"
+#include "GameCore.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+static_assert(TETRIS_WIDTH == Board::WIDTH && TETRIS_HEIGHT == Board::HEIGHT, "board size in the C API");
+static_assert(TETRIS_NEXT_COUNT == GameCore::NEXT_COUNT, "Next count in the C API");
+static_assert(TETRIS_ACTION_SONIC_DROP == static_cast<int>(Action::SonicDrop), "action numbers in the C API");
+
+namespace {
+    // 1つのタスクでまとめて進めるゲームの数（少ないとスレッドに渡す手間のほうが大きくなる）
+    const int GAMES_PER_TASK = 256;
+}
+
+struct TetrisEnv {
+    std::vector<GameCore> games;             // 描画しないので、どのゲームも盤面の色を持たない
+    std::uint64_t nextSeed = 0;              // 終わったゲームを始め直すときのシード
+    std::unique_ptr<ThreadPool> pool;        // threads == 1 なら作らない
+
+    // fn(i) を全ゲームについて実行する（ゲームが多ければスレッドに分ける）
+    // ワーカーで投げられた例外はそこで止め、全タスクが終わってから呼び出し元のスレッドで投げ直す
+    template <typename Fn>
+    void forEachGame(Fn fn) const {
+        int count = static_cast<int>(games.size());
+        int tasks = (count + GAMES_PER_TASK - 1) / GAMES_PER_TASK;
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        auto run = [&](int task, int) {
+            try {
+                int end = std::min(count, (task + 1) * GAMES_PER_TASK);
+                for (int i = task * GAMES_PER_TASK; i < end; ++i) fn(i);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) error = std::current_exception();
+            }
+        };
+        if (pool && tasks > 1) pool->parallelFor(tasks, run);
+        else for (int t = 0; t < tasks; ++t) run(t, 0);
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+extern "C" {
+
+uint32_t tetris_env_abi_version(void) {
+    return TETRIS_ENV_ABI_VERSION;
+}
+
+TetrisEnv* tetris_env_create(int32_t count, uint64_t seed, int32_t threads) {
+    if (count <= 0 || threads < 0) return nullptr;
+    try {
+        std::unique_ptr<TetrisEnv> env(new TetrisEnv());
+        env->games.reserve(count);
+        for (int32_t i = 0; i < count; ++i) env->games.emplace_back(seed + static_cast<std::uint64_t>(i), false);
+        env->nextSeed = seed + static_cast<std::uint64_t>(count);
+        if (threads != 1) env->pool = std::make_unique<ThreadPool>(threads);
+        return env.release();
+    }
+    catch (...) {
+        // メモリ不足やスレッドを作れなかったとき（std::system_error）も、C の呼び出し元へ例外を出さず NULL を返す
+        return nullptr;
+    }
+}
+
+void tetris_env_destroy(TetrisEnv* env) {
+    delete env;
+}
+
+int32_t tetris_env_count(const TetrisEnv* env) {
+    return env ? static_cast<int32_t>(env->games.size()) : 0;
+}
+
+int32_t tetris_env_reset(TetrisEnv* env, int32_t index, uint64_t seed) {
+    if (!env || index < -1 || index >= static_cast<int32_t>(env->games.size())) return -1;
+    try {
+        if (index >= 0) {
+            env->games[index] = GameCore(seed, false);
+            return 0;
+        }
+        env->forEachGame([&](int i) { env->games[i] = GameCore(seed + static_cast<std::uint64_t>(i), false); });
+        return 0;
+    }
+    catch (...) {
+        // GameCore を作るときのメモリ不足（std::bad_alloc）を C の呼び出し元へ出さない
+        return -1;
+    }
+}
+
+int32_t tetris_env_step(TetrisEnv* env, const int32_t* actions, const TetrisStepResult* result) {
+    if (!env || !actions) return -1;
+    int count = static_cast<int>(env->games.size());
+    for (int i = 0; i < count; ++i)
+        if (actions[i] < 0 || actions[i] >= TETRIS_ACTION_COUNT) return -1;
+
+    // 終わったゲームを始め直すシードは、スレッドの実行順によらないようゲームの番号から決める
+    std::uint64_t seedBase = env->nextSeed;
+    env->nextSeed += static_cast<std::uint64_t>(count);
+
+    try {
+        env->forEachGame([&](int i) {
+            GameCore& game = env->games[i];
+            StepResult r = game.step(static_cast<Action>(actions[i]));
+            if (r.gameOver) game = GameCore(seedBase + static_cast<std::uint64_t>(i), false);
+            if (!result) return;
+            if (result->linesCleared) result->linesCleared[i] = r.linesCleared;
+            if (result->locked) result->locked[i] = r.locked ? 1 : 0;
+            if (result->done) result->done[i] = r.gameOver ? 1 : 0;
+        });
+        return 0;
+    }
+    catch (...) {
+        // 終わったゲームを始め直すときのメモリ不足を C の呼び出し元へ出さない
+        return -1;
+    }
+}
+
+void tetris_env_observe(const TetrisEnv* env, const TetrisObservation* out) {
+    if (!env || !out) return;
+    env->forEachGame([&](int i) {
+        const GameCore& game = env->games[i];
+
+        // 盤面：行のビットを1マス1バイトに広げる
+        if (out->board) {
+            std::uint8_t* cells = out->board + static_cast<std::size_t>(i) * TETRIS_HEIGHT * TETRIS_WIDTH;
+            const Board& board = game.getBoard();
+            for (int y = 0; y < TETRIS_HEIGHT; ++y)
+                for (int x = 0; x < TETRIS_WIDTH; ++x)
+                    cells[y * TETRIS_WIDTH + x] = static_cast<std::uint8_t>((board.rows[y] >> x) & 1u);
+        }
+
+        const Piece& piece = game.getCurrentPiece();
+        if (out->current) out->current[i] = static_cast<std::int8_t>(piece.type);
+        if (out->piece) {
+            out->piece[i * 3 + 0] = static_cast<std::int8_t>(piece.x);
+            out->piece[i * 3 + 1] = static_cast<std::int8_t>(piece.y);
+            out->piece[i * 3 + 2] = static_cast<std::int8_t>(piece.rotation);
+        }
+        if (out->hold) out->hold[i] = game.getHoldPiece() ? static_cast<std::int8_t>(game.getHoldPiece()->type) : -1;
+        if (out->holdUsed) out->holdUsed[i] = game.getGameState().holdUsed ? 1 : 0;
+        if (out->queue) {
+            const auto& next = game.getNextQueue();
+            for (int k = 0; k < TETRIS_NEXT_COUNT; ++k)
+                out->queue[i * TETRIS_NEXT_COUNT + k] = k < static_cast<int>(next.size()) ? static_cast<std::int8_t>(next[k]) : -1;
+        }
+    });
+}
+
+}
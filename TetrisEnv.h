@@ -0,0 +1,101 @@
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+// TetrisEnv について（C から呼べる共有ライブラリの API）
+// ウィンドウを持たないゲーム（GameCore）を count 個まとめて作り、1回の呼び出しで全部を1操作ずつ進める
+// 観測（盤面・現在のピース・Hold・Next）は、呼び出し側が用意した連続したバッファへ直接書き込むので、
+// 文字列にしたり、ゲームごとに構造体をコピーしたりする必要がない
+//
+// ABI を保つための決まり:
+//   ・型は固定幅の整数と、中身を見せないハンドル（TetrisEnv*）だけを使う
+//   ・構造体を変えるときは TETRIS_ENV_ABI_VERSION を上げる（呼び出し側は tetris_env_abi_version() で確かめる）
+//   ・1つの TetrisEnv を同時に複数のスレッドから操作しないこと（別の TetrisEnv なら並行してよい）
+
+#if defined(_WIN32)
+#  if defined(TETRIS_ENV_BUILD)
+#    define TETRIS_ENV_API __declspec(dllexport)
+#  else
+#    define TETRIS_ENV_API __declspec(dllimport)
+#  endif
+#else
+#  define TETRIS_ENV_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TETRIS_ENV_ABI_VERSION 1
+
+enum {
+    TETRIS_WIDTH = 10,
+    TETRIS_HEIGHT = 20,
+    TETRIS_NEXT_COUNT = 5
+};
+
+// 操作（GameCore.hpp の Action と同じ番号）
+enum {
+    TETRIS_ACTION_NONE = 0,
+    TETRIS_ACTION_LEFT = 1,
+    TETRIS_ACTION_RIGHT = 2,
+    TETRIS_ACTION_SOFT_DROP = 3,
+    TETRIS_ACTION_UP = 4,
+    TETRIS_ACTION_ROTATE_LEFT = 5,
+    TETRIS_ACTION_ROTATE_RIGHT = 6,
+    TETRIS_ACTION_HARD_DROP = 7,
+    TETRIS_ACTION_HOLD = 8,
+    TETRIS_ACTION_GRAVITY = 9,
+    TETRIS_ACTION_DAS_LEFT = 10,
+    TETRIS_ACTION_DAS_RIGHT = 11,
+    TETRIS_ACTION_SONIC_DROP = 12,
+    TETRIS_ACTION_COUNT = 13
+};
+
+// ピースの種類は PieceType と同じ番号（T=0, S=1, Z=2, I=3, O=4, L=5, J=6）、-1 は「なし」
+
+typedef struct TetrisEnv TetrisEnv;
+
+// 観測の書き込み先（count はゲームの数。NULL の項目は書かない）
+typedef struct TetrisObservation {
+    uint8_t* board;      // [count][TETRIS_HEIGHT][TETRIS_WIDTH] 埋まっていれば 1（y = 0 が一番上）
+    int8_t* current;     // [count] 現在のピースの種類
+    int8_t* piece;       // [count][3] 現在のピースの x, y, 回転状態
+    int8_t* hold;        // [count] Hold 中の種類
+    uint8_t* holdUsed;   // [count] このターンで Hold を使ったか
+    int8_t* queue;       // [count][TETRIS_NEXT_COUNT] Next
+} TetrisObservation;
+
+// 1操作の結果の書き込み先（NULL の項目は書かない）
+typedef struct TetrisStepResult {
+    int32_t* linesCleared; // [count] この操作で消えたライン数
+    uint8_t* locked;       // [count] ピースが固定されたか
+    uint8_t* done;         // [count] ゲームが終わったか（終わったゲームは新しいシードで始め直してある）
+} TetrisStepResult;
+
+// ライブラリの ABI の版（TETRIS_ENV_ABI_VERSION と比べる）
+TETRIS_ENV_API uint32_t tetris_env_abi_version(void);
+
+// count 個のゲームを作る（i 番目のシードは seed + i）
+// threads: 1 ならスレッドを使わない、0 ならハードウェアのスレッド数。失敗したら NULL
+TETRIS_ENV_API TetrisEnv* tetris_env_create(int32_t count, uint64_t seed, int32_t threads);
+TETRIS_ENV_API void tetris_env_destroy(TetrisEnv* env);
+
+TETRIS_ENV_API int32_t tetris_env_count(const TetrisEnv* env);
+
+// index 番目のゲームをシード seed で始め直す（index が -1 なら全部、i 番目のシードは seed + i）
+// 成功なら 0、index が範囲外なら -1
+// メモリが足りず始め直せなかったときも -1（始め直せなかったゲームは元のまま）
+TETRIS_ENV_API int32_t tetris_env_reset(TetrisEnv* env, int32_t index, uint64_t seed);
+
+// 全ゲームを actions[i] で1操作ずつ進める（actions は [count]）
+// 成功なら 0、知らない操作があれば何も進めずに -1
+// 終わったゲームを始め直す途中でメモリが足りなくなったときも -1（一部のゲームだけ進んでいることがある）
+TETRIS_ENV_API int32_t tetris_env_step(TetrisEnv* env, const int32_t* actions, const TetrisStepResult* result);
+
+// 全ゲームの今の観測を書き込む
+TETRIS_ENV_API void tetris_env_observe(const TetrisEnv* env, const TetrisObservation* out);
+
+#ifdef __cplusplus
+}
+#endif
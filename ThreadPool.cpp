@@ -0,0 +1,114 @@
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+// コンストラクタ：ワーカーとタスク列を作って起動する
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads <= 0) threads = 1;
+
+    for (int i = 0; i < threads; ++i) queues.push_back(std::make_unique<WorkQueue>());
+    for (int i = 0; i < threads; ++i) workers.emplace_back([this, i] { workerLoop(i); });
+}
+
+// デストラクタ：ワーカーを起こして終了を待つ
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& w : workers) w.join();
+}
+
+// タスク列に振り分けて積み、寝ているワーカーを1つ起こす
+void ThreadPool::push(Task task) {
+    unsigned id = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    {
+        std::lock_guard<std::mutex> lock(queues[id]->mutex);
+        queues[id]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued.fetch_add(1, std::memory_order_release);
+    }
+    wake.notify_one();
+}
+
+bool ThreadPool::popLocal(int id, Task& task) {
+    if (id >= static_cast<int>(queues.size())) return false;
+    WorkQueue& q = *queues[id];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty()) return false;
+    task = std::move(q.tasks.back());
+    q.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::steal(int id, Task& task) {
+    int n = static_cast<int>(queues.size());
+    for (int k = 1; k <= n; ++k) {
+        WorkQueue& q = *queues[(id + k) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty()) continue;
+        task = std::move(q.tasks.front());
+        q.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::tryRun(int id) {
+    Task task;
+    if (!popLocal(id, task) && !steal(id, task)) return false;
+    queued.fetch_sub(1, std::memory_order_acq_rel);
+    task(id);
+    return true;
+}
+
+// ワーカーのメインループ：仕事があれば実行し、なければ積まれるまで寝る
+void ThreadPool::workerLoop(int id) {
+    for (;;) {
+        if (tryRun(id)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+        if (stopping && queued.load(std::memory_order_acquire) == 0) return;
+    }
+}
+
+// 範囲をいくつかの塊に分けて積み、呼び出し元も一緒に実行して全部終わるまで待つ
+void ThreadPool::parallelFor(int count, const std::function<void(int, int)>& fn) {
+    if (count <= 0) return;
+
+    // 1つの塊が小さすぎると積む手間が勝つので、ワーカー数の数倍程度に分ける
+    int chunks = std::min(count, size() * 4);
+    int chunkSize = (count + chunks - 1) / chunks;
+
+    struct Batch {
+        std::atomic<int> remaining;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto batch = std::make_shared<Batch>();
+    batch->remaining = 0;
+
+    for (int begin = 0; begin < count; begin += chunkSize) {
+        int end = std::min(count, begin + chunkSize);
+        batch->remaining.fetch_add(1, std::memory_order_relaxed);
+        push([batch, begin, end, &fn](int worker) {
+            for (int i = begin; i < end; ++i) fn(i, worker);
+            if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock(batch->mutex);
+                batch->done.notify_all();
+            }
+        });
+    }
+
+    // 呼び出し元も size() 番のワーカーとして盗みに参加する
+    int self = size();
+    while (batch->remaining.load(std::memory_order_acquire) > 0) {
+        if (tryRun(self)) continue;
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        batch->done.wait(lock, [&] { return batch->remaining.load(std::memory_order_acquire) == 0; });
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ThreadPool について
+// ワーカーごとに自分専用のタスク列（deque）を持ち、自分の列は後ろから、
+// 空になったら他のワーカーの列の前から盗んで実行する（ワークスティーリング）
+// 1つのタスクが重くても、手の空いたワーカーが残りを引き取るので全コアが埋まりやすい
+class ThreadPool {
+public:
+    // threads = 0 ならハードウェアのスレッド数だけワーカーを作る
+    explicit ThreadPool(int threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // ワーカー数
+    int size() const { return static_cast<int>(workers.size()); }
+
+    // fn(i, worker) を i = 0..count-1 について実行し、すべて終わるまで待つ
+    // worker は 0..size() の番号で、呼び出し元のスレッドも size() 番として手伝う
+    // （ワーカーごとの作業領域を size() + 1 個用意しておけば排他なしで使える）
+    // 呼び出し元の番号が重ならないよう、1つのプールに対して同時に呼べるのは1スレッドだけ
+    void parallelFor(int count, const std::function<void(int, int)>& fn);
+
+private:
+    using Task = std::function<void(int)>;
+
+    // ワーカー1つ分のタスク列
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues;
+
+    std::mutex sleepMutex;                   // 仕事待ちのワーカーを寝かせるためのロック
+    std::condition_variable wake;
+    std::atomic<int> queued{ 0 };            // 全タスク列に積まれている数
+    std::atomic<unsigned> nextQueue{ 0 };    // 外部から積むときの振り分け先
+    bool stopping = false;
+
+    void push(Task task);
+    bool popLocal(int id, Task& task);       // 自分の列の後ろから取る
+    bool steal(int id, Task& task);          // 他の列の前から盗む
+    bool tryRun(int id);                     // 1つ取って実行できたら true
+    void workerLoop(int id);
+};
@@ -0,0 +1,53 @@
+#include "Zobrist.hpp"
+#include <cstring>
+
+// コンストラクタ：2^bits 個のエントリを確保する（すべて世代 0 = 空）
+TranspositionTable::TranspositionTable(int bits)
+    : slots(new Slot[std::size_t(1) << bits]), mask((std::uint64_t(1) << bits) - 1)
+{
+}
+
+void TranspositionTable::clear() {
+    for (std::uint64_t i = 0; i <= mask; ++i) {
+        slots[i].check.store(0, std::memory_order_relaxed);
+        slots[i].data.store(0, std::memory_order_relaxed);
+    }
+}
+
+// 今の世代で key のエントリがあれば返す
+bool TranspositionTable::probe(std::uint64_t key, Entry& out) const {
+    const Slot& slot = slots[key & mask];
+    std::uint64_t data = slot.data.load(std::memory_order_relaxed);
+    std::uint64_t check = slot.check.load(std::memory_order_relaxed);
+    if ((check ^ data) != key) return false;
+
+    Entry entry = unpack(data);
+    if (entry.generation != generation) return false;
+    out = entry;
+    return true;
+}
+
+// key のエントリを書く
+void TranspositionTable::store(std::uint64_t key, const Entry& entry) {
+    Slot& slot = slots[key & mask];
+    Entry e = entry;
+    e.generation = generation;
+    std::uint64_t data = pack(e);
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+std::uint64_t TranspositionTable::pack(const Entry& entry) {
+    std::uint32_t scoreBits;
+    std::memcpy(&scoreBits, &entry.score, sizeof(scoreBits));
+    return (std::uint64_t(scoreBits) << 32) | (std::uint64_t(entry.depth) << 16) | entry.generation;
+}
+
+TranspositionTable::Entry TranspositionTable::unpack(std::uint64_t data) {
+    Entry entry;
+    std::uint32_t scoreBits = static_cast<std::uint32_t>(data >> 32);
+    std::memcpy(&entry.score, &scoreBits, sizeof(scoreBits));
+    entry.depth = static_cast<std::uint16_t>(data >> 16);
+    entry.generation = static_cast<std::uint16_t>(data);
+    return entry;
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Zobrist ハッシュについて
+// 盤面の各マス・現在のピース・Hold・Nextの位置ごとにランダムな64bitの値を割り当て、
+// 「埋まっているマス（や状態）の値をすべて XOR したもの」を局面のハッシュとする
+// マスを1つ埋める/空けるたびに XOR 1回で更新できるので、Board が置くたびに持ち回る
+// 置く順番が違っても同じ盤面になれば同じ値になり、探索で同じ局面を見分けられる
+
+// 決まった値から乱数列を作る（SplitMix64、毎回同じ表になる）
+constexpr std::uint64_t zobristMix(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+struct ZobristKeys {
+    static const int MAX_WIDTH = 16;
+    static const int MAX_HEIGHT = 48;
+    static const int MAX_QUEUE = 16;
+
+    std::array<std::array<std::uint64_t, MAX_WIDTH>, MAX_HEIGHT> cell;  // cell[y][x]
+    std::array<std::uint64_t, 7> piece;          // 現在のピースの種類
+    std::array<std::uint64_t, 8> hold;           // Hold の種類（0 が空、1..7 が PieceType + 1）
+    std::array<std::uint64_t, MAX_QUEUE> queue;  // 次に使うピースの位置
+    std::array<std::uint64_t, 128> bag;          // 袋に残っている種類（7bit のマスク）
+};
+
+constexpr ZobristKeys makeZobristKeys() {
+    ZobristKeys keys{};
+    std::uint64_t n = 0;
+    for (auto& row : keys.cell)
+        for (auto& k : row) k = zobristMix(++n);
+    for (auto& k : keys.piece) k = zobristMix(++n);
+    for (auto& k : keys.hold) k = zobristMix(++n);
+    keys.hold[0] = 0;  // Hold が空なら何も混ぜない
+    for (auto& k : keys.queue) k = zobristMix(++n);
+    for (auto& k : keys.bag) k = zobristMix(++n);
+    return keys;
+}
+
+constexpr ZobristKeys ZOBRIST = makeZobristKeys();
+
+// 盤面のハッシュに、現在のピース・Hold・Nextの位置を混ぜた探索状態のハッシュ
+// hold は -1 が空、0..6 が PieceType
+inline std::uint64_t searchStateHash(std::uint64_t boardHash, int current, int hold, int queueIndex) {
+    return boardHash ^ ZOBRIST.piece[current] ^ ZOBRIST.hold[hold + 1]
+        ^ ZOBRIST.queue[queueIndex % ZobristKeys::MAX_QUEUE];
+}
+
+// Next を使い切ったあとの局面（盤面・Hold・袋の残り）のハッシュ
+// 次に出るピースが決まっていないので、現在のピースの代わりに袋の残りを混ぜる
+inline std::uint64_t chanceStateHash(std::uint64_t boardHash, int hold, std::uint8_t bag) {
+    return boardHash ^ ZOBRIST.hold[hold + 1] ^ ZOBRIST.bag[bag & 0x7F];
+}
+
+// ==== 置換表（トランスポジションテーブル） ====
+// 固定サイズ（2のべき乗）のハッシュ表で、ロックを使わずに複数スレッドから読み書きできる
+// 各エントリは (key ^ data, data) の2語で保存し、読むときに key を復元して一致を確かめる
+// 別スレッドの書き込みと混ざった壊れたエントリは key が一致しないので「見つからない」扱いになる
+class TranspositionTable {
+public:
+    // 1エントリに入れる値
+    struct Entry {
+        float score;              // 評価値
+        std::uint16_t depth;      // 何手目で見つけたか
+        std::uint16_t generation; // どの探索で書いたか（古いものは無視する）
+    };
+
+    // 2^bits 個のエントリを確保する
+    explicit TranspositionTable(int bits = 18);
+
+    // 新しい探索を始める（それより前に書いたエントリは無効になる）
+    // 世代の番号が一周したら、65535 回前の探索のエントリが今の世代に見えないよう表を空にする
+    // （ほかのスレッドが読み書きしていないときに呼ぶこと）
+    void newGeneration() {
+        if (++generation == 0) {
+            clear();
+            generation = 1;
+        }
+    }
+
+    // すべてのエントリを消す
+    void clear();
+    std::uint16_t currentGeneration() const { return generation; }
+
+    // 今の世代で key のエントリがあれば out に書いて true
+    bool probe(std::uint64_t key, Entry& out) const;
+
+    // key のエントリを書く（同じ場所の古い値は上書き）
+    void store(std::uint64_t key, const Entry& entry);
+
+private:
+    struct Slot {
+        std::atomic<std::uint64_t> check{ 0 };  // key ^ data
+        std::atomic<std::uint64_t> data{ 0 };
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::uint64_t mask;
+    std::uint16_t generation = 1;
+
+    static std::uint64_t pack(const Entry& entry);
+    static Entry unpack(std::uint64_t data);
+};
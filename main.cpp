@@ -1,5 +1,5 @@
 /*
-#include "Piece.hpp"
+#include "Game.hpp"
 
 int main() {
     Game game;
@@ -9,16 +9,15 @@ int main() {
 */
 
 #include <iostream>
-#include "Piece.hpp"
-#include "Board.hpp"
+#include "GameCore.hpp"
 
 int main() {
 
-    Game game;
-    Board board;
+    // ウィンドウを開かずにゲーム本体だけを作る
+    GameCore core;
 
     // 現在のゲーム状態を取得
-    GameState state = game.getGameState();
+    GameState state = core.getGameState();
 
     std::cout << "Current Piece: " << pieceTypeToString(state.currentPiece) << std::endl;
 
@@ -33,13 +32,11 @@ int main() {
 
     /*
     * ブロック設置
-    board.placeBlock(3, 0, sf::Color::Red);
-    board.placeBlock(4, 0, sf::Color::Red);
-    board.placeBlock(5, 1, sf::Color::Red);
+    core.step(Action::HardDrop);
     */
 
     // 盤面を文字列として取得
-    std::string boardState = board.toString();
+    std::string boardState = core.getBoard().toString();
     // 表示
     std::cout << boardState;
 
@@ -0,0 +1,314 @@
+// bench: Board と Piece のよく呼ばれる処理を1回あたりの時間（ns/op）で測るツール
+// ビルドごとに同じ条件で測り、前の結果と比べて遅くなっていないかを確かめるのに使う
+// 盤面・ピース・Bag はすべて固定のシードから作るので、何度実行しても同じ入力を測る
+//
+// 使い方:
+//   bench                          すべて測り、CSV で出力する
+//   bench --filter clear_lines     名前に clear_lines を含むものだけ測る
+//   bench --min-time 200 --repeats 9
+//                                  1回の計測を 200ms 以上にし、9回測った中央値を出す
+//
+// 出力（CSV、1行目は見出し）:
+//   benchmark,iterations,ns_per_op,min_ns_per_op
+// ns_per_op は repeats 回の計測の中央値、min_ns_per_op は最小値（iterations は1回の計測での回数）
+
+#include "../SelfPlay.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // 結果を捨てられないよう、計測ごとの合計をここに書く
+    volatile std::uint64_t sink = 0;
+
+    struct BenchOptions {
+        std::string filter;
+        double minTimeMs = 50.0;
+        int repeats = 5;
+    };
+
+    // batch(n) は n 回の操作を行い、結果を混ぜた値を返す
+    template <typename Batch>
+    void runBench(const BenchOptions& options, const std::string& name, Batch&& batch) {
+        if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+
+        auto timeBatch = [&](std::uint64_t n) {
+            auto start = std::chrono::steady_clock::now();
+            sink = sink + batch(n);
+            return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        };
+
+        // 1回の計測が minTimeMs を超える回数まで倍々に増やす
+        std::uint64_t n = 64;
+        while (timeBatch(n) < options.minTimeMs * 1e6 && n < (std::uint64_t(1) << 40)) n *= 2;
+
+        std::vector<double> samples;
+        for (int r = 0; r < options.repeats; ++r) samples.push_back(timeBatch(n) / static_cast<double>(n));
+        std::sort(samples.begin(), samples.end());
+        std::cout << name << ',' << n << ',' << samples[samples.size() / 2] << ',' << samples.front() << std::endl;
+    }
+
+    // 入力の表の大きさ（2の累乗。同じ引数が続いてループの外へ出されないよう、毎回違う入力を使う）
+    const std::size_t INPUTS = 1024;
+
+    // 下から height 行を埋め、そのうち一番下の lines 行は揃っている盤面
+    // 揃っていない行は1マスだけ空ける（空ける列は rng で決める）
+    Board makeStack(std::mt19937& rng, int height, int lines) {
+        Board board(false);
+        for (int i = 0; i < height; ++i) {
+            int y = Board::HEIGHT - 1 - i;
+            board.rows[y] = Board::FULL_ROW;
+            if (i >= lines) board.rows[y] = static_cast<Board::Row>(board.rows[y] & ~(1u << (rng() % Board::WIDTH)));
+        }
+        board.rehash();
+        return board;
+    }
+
+    // 空きの多い、でこぼこな積み方（高さは列ごとに 0〜maxHeight）
+    Board makeRagged(std::mt19937& rng, int maxHeight) {
+        Board board(false);
+        for (int x = 0; x < Board::WIDTH; ++x) {
+            int h = static_cast<int>(rng() % (maxHeight + 1));
+            for (int i = 0; i < h; ++i)
+                if (rng() % 4 != 0) board.rows[Board::HEIGHT - 1 - i] |= static_cast<Board::Row>(1u << x);
+        }
+        board.rehash();
+        return board;
+    }
+
+    // 盤面の中のどこかにあるピース（盤面からはみ出すこともある）
+    std::vector<Piece> makePieces(std::mt19937& rng) {
+        std::vector<Piece> pieces;
+        pieces.reserve(INPUTS);
+        for (std::size_t i = 0; i < INPUTS; ++i) {
+            Piece p(static_cast<PieceType>(rng() % 7));
+            p.rotation = static_cast<Rotation>(rng() % 4);
+            p.blocks = p.getRotatedCells(static_cast<int>(p.rotation));
+            p.x = static_cast<int>(rng() % (Board::WIDTH + 2)) - 1;
+            p.y = static_cast<int>(rng() % (Board::HEIGHT + 2)) - 1;
+            pieces.push_back(p);
+        }
+        return pieces;
+    }
+
+    // ピースの4マス以外がすべて埋まった盤面：どちら向きの回転もすべてのキックを試して失敗する
+    struct BlockedRotation {
+        Board board{ false };
+        Piece piece{ PieceType::T };
+    };
+
+    std::vector<BlockedRotation> makeBlockedRotations() {
+        std::vector<BlockedRotation> cases;
+        for (int t = 0; t < 7; ++t) {
+            for (int r = 0; r < 4; ++r) {
+                BlockedRotation c;
+                c.piece = Piece(static_cast<PieceType>(t));
+                c.piece.rotation = static_cast<Rotation>(r);
+                c.piece.blocks = c.piece.getRotatedCells(r);
+                c.piece.x = 3;
+                c.piece.y = 8;
+                c.board.rows.fill(Board::FULL_ROW);
+                for (const auto& cell : c.piece.getAbsolutePositions())
+                    c.board.rows[cell.y] = static_cast<Board::Row>(c.board.rows[cell.y] & ~(1u << cell.x));
+                c.board.rehash();
+
+                // O のように形が変わらず回れてしまうものは除く
+                Piece a = c.piece, b = c.piece;
+                if (!a.rotate(c.board, true) && !b.rotate(c.board, false)) cases.push_back(c);
+            }
+        }
+        return cases;
+    }
+
+    // 置いて消す流れの入力：ホールドなしのボットが1局で選んだ配置を順に並べたもの
+    std::vector<Placement> recordPlacements(std::uint64_t seed, int pieces) {
+        BotConfig config;
+        config.beamWidth = 16;
+        config.maxDepth = 2;
+        config.useHold = false;
+        config.threads = 1;
+        config.timeBudgetUs = 0;
+        BeamSearchBot bot(config);
+        GameOutcome game = playGame(bot, seed, pieces, false, true);
+
+        std::vector<Placement> placements;
+        for (const DatasetRecord& r : game.samples)
+            placements.push_back({ static_cast<PieceType>(r.current), static_cast<Rotation>(r.rotation), r.x, r.y });
+        return placements;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue) options.filter = argv[++i];
+        else if (arg == "--min-time" && hasValue) options.minTimeMs = std::atof(argv[++i]);
+        else if (arg == "--repeats" && hasValue) options.repeats = std::max(1, std::atoi(argv[++i]));
+        else {
+            std::cerr << "usage: bench [--filter NAME] [--min-time MS] [--repeats N]" << std::endl;
+            return 2;
+        }
+    }
+
+    std::mt19937 rng(12345);
+    const std::size_t MASK = INPUTS - 1;
+    std::cout << "benchmark,iterations,ns_per_op,min_ns_per_op" << std::endl;
+
+    // ==== Board::isOccupied ====
+    {
+        Board board = makeRagged(rng, 12);
+        std::vector<std::pair<int, int>> cells;
+        for (std::size_t i = 0; i < INPUTS; ++i)
+            cells.push_back({ static_cast<int>(rng() % (Board::WIDTH + 2)) - 1, static_cast<int>(rng() % (Board::HEIGHT + 2)) - 1 });
+        runBench(options, "board_is_occupied", [&](std::uint64_t n) {
+            std::uint64_t sum = 0;
+            for (std::uint64_t i = 0; i < n; ++i) {
+                const auto& c = cells[i & MASK];
+                sum += board.isOccupied(c.first, c.second);
+            }
+            return sum;
+        });
+    }
+
+    // ==== Board::clearLines（盤面を戻す時間を含む。board_restore がその分） ====
+    {
+        Board board(false);
+        std::vector<BitBoard> empty(INPUTS, BitBoard());
+        runBench(options, "board_restore", [&](std::uint64_t n) {
+            std::uint64_t sum = 0;
+            for (std::uint64_t i = 0; i < n; ++i) {
+                static_cast<BitBoard&>(board) = empty[i & MASK];
+                sum += board.cellCount;
+            }
+            return sum;
+        });
+
+        for (int height : { 4, 10, 18 }) {
+            for (int lines = 0; lines <= 4; ++lines) {
+                std::vector<BitBoard> stacks;
+                for (std::size_t i = 0; i < INPUTS; ++i) stacks.push_back(makeStack(rng, height, lines));
+                runBench(options, "board_clear_lines/h" + std::to_string(height) + "/l" + std::to_string(lines),
+                    [&](std::uint64_t n) {
+                        std::uint64_t sum = 0;
+                        for (std::uint64_t i = 0; i < n; ++i) {
+                            static_cast<BitBoard&>(board) = stacks[i & MASK];
+                            sum += board.clearLines();
+                        }
+                        return sum;
+                    });
+            }
+        }
+    }
+
+    // ==== Piece::canMove / Piece::collides ====
+    {
+        Board empty(false);
+        Board stack = makeRagged(rng, 12);
+        std::vector<Piece> pieces = makePieces(rng);
+        std::vector<int> dirs, rots;
+        for (std::size_t i = 0; i < INPUTS; ++i) {
+            dirs.push_back(static_cast<int>(rng() % 3));
+            rots.push_back(static_cast<int>(rng() % 4));
+        }
+        const int DX[3] = { -1, 1, 0 }, DY[3] = { 0, 0, 1 };
+
+        for (const Board* board : { &empty, &stack }) {
+            std::string suffix = board == &empty ? "/empty" : "/stack";
+            runBench(options, "piece_can_move" + suffix, [&](std::uint64_t n) {
+                std::uint64_t sum = 0;
+                for (std::uint64_t i = 0; i < n; ++i) {
+                    int d = dirs[i & MASK];
+                    sum += pieces[i & MASK].canMove(*board, DX[d], DY[d]);
+                }
+                return sum;
+            });
+            runBench(options, "piece_collides" + suffix, [&](std::uint64_t n) {
+                std::uint64_t sum = 0;
+                for (std::uint64_t i = 0; i < n; ++i) {
+                    int d = dirs[i & MASK];
+                    sum += pieces[i & MASK].collides(*board, DX[d], DY[d], rots[i & MASK]);
+                }
+                return sum;
+            });
+        }
+    }
+
+    // ==== Piece::rotate ====
+    {
+        // 空の盤面の中ほど：最初のキックで回れる
+        Board empty(false);
+        std::vector<Piece> pieces;
+        for (std::size_t i = 0; i < INPUTS; ++i) {
+            Piece p(static_cast<PieceType>(rng() % 7));
+            p.x = 3 + static_cast<int>(rng() % 3) - 1;
+            p.y = 8 + static_cast<int>(rng() % 3);
+            pieces.push_back(p);
+        }
+        runBench(options, "piece_rotate/first_kick", [&](std::uint64_t n) {
+            std::uint64_t sum = 0;
+            for (std::uint64_t i = 0; i < n; ++i) {
+                Piece p = pieces[i & MASK];
+                sum += p.rotate(empty, (i & 1) != 0) + p.x;
+            }
+            return sum;
+        });
+
+        // 周りが埋まっていて、すべてのキックを試して失敗する
+        std::vector<BlockedRotation> blocked = makeBlockedRotations();
+        runBench(options, "piece_rotate/all_kicks_blocked", [&](std::uint64_t n) {
+            std::uint64_t sum = 0;
+            for (std::uint64_t i = 0; i < n; ++i) {
+                BlockedRotation& c = blocked[i % blocked.size()];
+                Piece p = c.piece;
+                sum += p.rotate(c.board, (i & 1) != 0);
+            }
+            return sum;
+        });
+    }
+
+    // ==== Bag::getNext ====
+    {
+        Bag bag(42);
+        runBench(options, "bag_get_next", [&](std::uint64_t n) {
+            std::uint64_t sum = 0;
+            for (std::uint64_t i = 0; i < n; ++i) sum += static_cast<std::uint64_t>(bag.getNext());
+            return sum;
+        });
+    }
+
+    // ==== 置いて消す（色付きの盤面に1手置いてライン消去。ゲームと同じ Board を使う） ====
+    {
+        std::vector<Placement> placements = recordPlacements(7, 1000);
+        Board board;
+        std::size_t next = 0;
+        runBench(options, "place_and_clear", [&](std::uint64_t n) {
+            std::uint64_t sum = 0;
+            for (std::uint64_t i = 0; i < n; ++i) {
+                // 1局を置き終えたら空の盤面からやり直す
+                if (next == placements.size()) {
+                    board = Board();
+                    next = 0;
+                }
+                const Placement& pl = placements[next++];
+                Piece p(pl.type);
+                p.rotation = pl.rotation;
+                p.x = pl.x;
+                p.y = pl.y;
+                p.place(board);
+                sum += board.clearLines();
+            }
+            return sum;
+        });
+    }
+
+    return 0;
+}
@@ -0,0 +1,151 @@
+// pc: パーフェクトクリアの探索（PerfectClearSolver）が正しいかを確かめるツール
+//
+// 使い方:
+//   pc --verify                            ランダムな2段の盤面で、findAll の解の数を総当たりの数え上げと比べる
+//   pc --verify --boards 1000 --seed 7     盤面の数と乱数のシードを変える
+//
+// 総当たりは枝刈りもメモ化もせず、探索と同じ規則（下から lines 段の中にだけ置く・最初に盤面が空になった並びを
+// 1つの解とする・Hold して同じ種類になる手は数えない）ですべての (Hold するか, 置く位置) の並びをたどる
+
+#include "../PerfectClear.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+    struct BruteForce {
+        MoveGenerator gen;
+        SearchJournal journal;
+        const std::vector<PieceType>* queue = nullptr;
+
+        // height 段の領域を空にする並びの数
+        std::uint64_t count(SearchState& state, int height, int depth) {
+            if (state.board.cellCount == 0 && depth > 0) return 1;
+
+            std::uint64_t total = 0;
+            int regionTop = BitBoard::HEIGHT - height;
+            for (int option = 0; option < 2; ++option) {
+                bool useHold = option == 1;
+                int piece = state.current;
+                if (useHold) {
+                    if (state.hold >= 0) piece = state.hold;
+                    else if (state.cursor < static_cast<int>(queue->size())) piece = static_cast<int>((*queue)[state.cursor]);
+                    else break;
+                    if (piece == state.current) break;
+                }
+                if (piece < 0) continue;
+
+                std::vector<Placement> placements;
+                gen.generate(state.board, static_cast<PieceType>(piece), placements);
+                for (const Placement& p : placements) {
+                    const PieceMask& m = SRS_MASKS[piece][static_cast<int>(p.rotation)];
+                    if (p.y + m.minY < regionTop) continue;
+                    int lines = journal.apply(state, *queue, useHold, p);
+                    if (lines < 0) continue;
+                    total += count(state, height - lines, depth + 1);
+                    journal.undo(state);
+                }
+            }
+            return total;
+        }
+    };
+
+    // 下の2段を埋めておき、その中で重ならない2〜3個のピースの形をくり抜いた盤面
+    // くり抜いたピースの種類を pieces に返す（Next に混ぜると解のある盤面が多くなる）
+    BitBoard makeBoard(std::mt19937& rng, MoveGenerator& gen, std::vector<PieceType>& pieces) {
+        BitBoard cut;
+        pieces.clear();
+        int target = 2 + static_cast<int>(rng() % 2);
+        std::vector<Placement> placements;
+        for (int tries = 0; tries < 50 && static_cast<int>(pieces.size()) < target; ++tries) {
+            PieceType t = static_cast<PieceType>(rng() % 7);
+            gen.generate(cut, t, placements);
+            std::vector<Placement> inside;
+            for (const Placement& p : placements) {
+                const PieceMask& m = SRS_MASKS[static_cast<int>(t)][static_cast<int>(p.rotation)];
+                if (p.y + m.minY >= BitBoard::HEIGHT - 2) inside.push_back(p);
+            }
+            if (inside.empty()) continue;
+            const Placement& p = inside[rng() % inside.size()];
+            cut.placeMask(SRS_MASKS[static_cast<int>(t)][static_cast<int>(p.rotation)], p.x, p.y);
+            pieces.push_back(t);
+        }
+
+        BitBoard board;
+        for (int y = BitBoard::HEIGHT - 2; y < BitBoard::HEIGHT; ++y)
+            board.rows[y] = static_cast<BitBoard::Row>(BitBoard::FULL_ROW & ~cut.rows[y]);
+        board.rehash();
+        return board;
+    }
+
+    int verify(int boards, std::uint64_t seed) {
+        std::mt19937 rng(static_cast<std::uint32_t>(seed));
+        PcConfig config;
+        config.maxLines = 2;
+        config.timeBudgetUs = 0;
+        config.findAll = true;
+        config.maxSolutions = 1 << 30;
+        PerfectClearSolver solver(config);
+        BruteForce brute;
+
+        int failures = 0, solvable = 0;
+        for (int i = 0; i < boards; ++i) {
+            std::vector<PieceType> queue;
+            BitBoard board = makeBoard(rng, brute.gen, queue);
+            if (board.cellCount == 0) continue;
+            while (queue.size() < 6) queue.push_back(static_cast<PieceType>(rng() % 7));
+            std::shuffle(queue.begin(), queue.end(), rng);
+            PieceType current = queue.front();
+            queue.erase(queue.begin());
+            std::optional<PieceType> hold;
+            if (rng() % 2) hold = static_cast<PieceType>(rng() % 7);
+
+            PcResult r = solver.solve(board, current, hold, queue);
+
+            SearchState state;
+            state.board = board;
+            state.current = static_cast<std::int8_t>(current);
+            state.hold = hold ? static_cast<std::int8_t>(*hold) : -1;
+            brute.queue = &queue;
+            std::uint64_t expected = brute.count(state, 2, 0);
+
+            if (expected > 0) ++solvable;
+            if (r.solutions.size() != expected || r.found != (expected > 0)) {
+                ++failures;
+                std::cout << "FAIL board " << i << " solver=" << r.solutions.size() << " brute=" << expected << std::endl;
+                std::cout << board.toString();
+            }
+        }
+        std::cout << "boards=" << boards << " solvable=" << solvable << " mismatches=" << failures << std::endl;
+        std::cout << (failures == 0 ? "all solution counts match" : "mismatch found") << std::endl;
+        return failures == 0 ? 0 : 1;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    bool runVerify = false;
+    int boards = 2000;
+    std::uint64_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--verify") runVerify = true;
+        else if (arg == "--boards" && hasValue) boards = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else {
+            runVerify = false;
+            break;
+        }
+    }
+    if (!runVerify) {
+        std::cerr << "usage: pc --verify [--boards N] [--seed S]" << std::endl;
+        return 2;
+    }
+    return verify(boards, seed);
+}
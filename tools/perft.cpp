@@ -0,0 +1,338 @@
+// perft: 指定した盤面とピース列から、到達可能な配置の並びを深さ depth まで数えるツール
+// チェスエンジンの perft と同じく、MoveGenerator と SRS の表が正しいかの回帰確認と、
+// ビルドごとの速度比較（nodes/s）に使う
+//
+// 使い方:
+//   perft --verify                         基準局面の数え上げが期待値と一致するか確認する
+//                                          （10 × 40 の BufferedBoard でも数え、その期待値と比べる）
+//   perft --seq TSZIO --depth 3            空の盤面でピース列 T,S,Z,I,O を深さ3まで数える
+//   perft --bag --seed 42 --depth 3        シード 42 の Bag から引いたピース列で数える（使った列も表示）
+//   perft --board "XXXX__XXXX/XXXXX_XXXX" --seq TT --depth 2
+//                                          盤面の下の行から上書きする（'/' 区切り、上の行から順、X が埋まり）
+//
+// ホールドは使わず、ピース列の順に1つずつ置く。置いたあとはライン消去してから次へ進む
+// 局面は1つの SearchState を SearchJournal で進めて戻すだけで、盤面のコピーは作らない
+
+#include "../MoveGen.hpp"
+#include "../SearchState.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+    // 深さごとに使い回す配置バッファ（再帰のたびに確保しない）
+    struct PerftContext {
+        MoveGenerator gen;
+        SearchJournal journal;
+        std::vector<std::vector<Placement>> buffers;
+    };
+
+    // state から depth 個を置く並びの数
+    std::uint64_t perft(PerftContext& ctx, SearchState& state, const std::vector<PieceType>& sequence, int ply, int depth) {
+        if (depth == 0) return 1;
+
+        std::vector<Placement>& placements = ctx.buffers[ply];
+        int count = ctx.gen.generate(state.board, static_cast<PieceType>(state.current), placements);
+        if (depth == 1) return static_cast<std::uint64_t>(count);
+
+        std::uint64_t nodes = 0;
+        for (int i = 0; i < count; ++i) {
+            ctx.journal.apply(state, sequence, false, placements[i]);
+            nodes += perft(ctx, state, sequence, ply + 1, depth - 1);
+            ctx.journal.undo(state);
+        }
+        return nodes;
+    }
+
+    std::uint64_t runPerft(const Board& board, const std::vector<PieceType>& sequence, int depth) {
+        PerftContext ctx;
+        ctx.buffers.resize(depth);
+        SearchState state;
+        state.board = board;
+        state.current = static_cast<std::int8_t>(sequence[0]);
+        state.cursor = 1;
+        return perft(ctx, state, sequence, 0, depth);
+    }
+
+    // "TSZ" → {T, S, Z}（解釈できない文字があれば false）
+    bool parseSequence(const std::string& text, std::vector<PieceType>& out) {
+        out.clear();
+        for (char c : text) {
+            switch (c) {
+            case 'T': out.push_back(PieceType::T); break;
+            case 'S': out.push_back(PieceType::S); break;
+            case 'Z': out.push_back(PieceType::Z); break;
+            case 'I': out.push_back(PieceType::I); break;
+            case 'O': out.push_back(PieceType::O); break;
+            case 'L': out.push_back(PieceType::L); break;
+            case 'J': out.push_back(PieceType::J); break;
+            default: return false;
+            }
+        }
+        return true;
+    }
+
+    // 盤面の下側の行を上から順に並べたもの（X が埋まり）を空の盤面に書き込む（行数は盤面の高さ以下であること）
+    template <typename BoardType>
+    void fillRows(BoardType& board, const std::vector<std::string>& rows) {
+        int y = BoardType::HEIGHT - static_cast<int>(rows.size());
+        for (const auto& row : rows) {
+            for (int x = 0; x < BoardType::WIDTH && x < static_cast<int>(row.size()); ++x)
+                if (row[x] == 'X') board.rows[y] |= static_cast<typename BoardType::Row>(1u << x);
+            ++y;
+        }
+        board.rehash();
+    }
+
+    Board makeBoard(const std::vector<std::string>& rows) {
+        Board board(false);
+        fillRows(board, rows);
+        return board;
+    }
+
+    std::vector<std::string> splitRows(const std::string& text) {
+        std::vector<std::string> rows;
+        std::string current;
+        for (char c : text) {
+            if (c == '/') { rows.push_back(current); current.clear(); }
+            else current += c;
+        }
+        rows.push_back(current);
+        return rows;
+    }
+
+    // ==== 基準局面 ====
+    // 期待値はこの MoveGenerator を Piece を1手ずつ動かす素朴な探索と照合したうえで記録したもの
+    // SRS の表や探索を変更してここがずれたら、回転規則が変わってしまっている
+    // bufferedExpected は同じ局面を 10 × 40 の盤面の下に置き、見える範囲の一番上から出して
+    // 深さ BUFFERED_DEPTH まで数えた数（積みが低ければ上のバッファは空いているだけなので 10 × 20 と同じになり、
+    // high stack だけはバッファ側へ回り込めるぶん多い）
+    const int BUFFERED_DEPTH = 2;   // 10 × 40 は素朴な探索で数えるので浅くする
+
+    struct PerftPosition {
+        const char* name;
+        std::vector<std::string> rows;
+        const char* sequence;
+        int depth;
+        std::uint64_t expected;
+        std::uint64_t bufferedExpected;
+    };
+
+    const std::vector<PerftPosition>& referencePositions() {
+        static const std::vector<PerftPosition> positions = {
+            { "empty T",       {}, "T", 1, 34, 34 },
+            { "empty I",       {}, "I", 1, 17, 17 },
+            { "empty O",       {}, "O", 1, 9, 9 },
+            { "empty TIO",     {}, "TIO", 3, 5578, 600 },
+            { "empty SZLJ",    {}, "SZLJ", 4, 388024, 296 },
+            { "tsd slot",
+              { "XX________",
+                "X___XXXXXX",
+                "XX_XXXXXXX" }, "TT", 2, 1359, 1359 },
+            { "tst slot",
+              { "_______XX_",
+                "________X_",
+                "XXXXXXX_X_",
+                "XXXXXX__XX",
+                "XXXXXXX_XX" }, "TLJ", 3, 46959, 1285 },
+            { "garbage",
+              { "X_XXXXXXXX",
+                "XXXX_XXXXX",
+                "XXXXXXX_XX",
+                "_XXXXXXXXX" }, "ISZO", 4, 48497, 289 },
+            { "high stack",
+              { "X_XX_XXXX_", "XXXXX_XXXX", "XXXX_XXXXX", "_XXXXXXXXX",
+                "XXXXXXXX_X", "XXX_XXXXXX", "X_XXXXXXXX", "XXXXXX_XXX",
+                "XXXX_XXXXX", "XX_XXXXXXX", "XXXXXXX_XX", "XXXXX_XXXX",
+                "X_XXXXXXXX", "XXX_XXXXXX", "XXXXXXXX_X", "XXXX_XXXXX" }, "JLT", 3, 14299, 1101 },
+        };
+        return positions;
+    }
+
+    // ==== ほかの大きさの盤面での数え上げ ====
+    // MoveGenerator は 10 × 20 専用なので、Piece を1手ずつ動かす素朴な探索で最終配置を集める
+    // （Piece::canMove / rotate、placeMask、clearLines を盤面の大きさごとの実体で通す）
+
+    // spawnY の出現位置から届く最終配置（埋まるマスが同じものは1つにまとめる）
+    template <int W, int H, int V>
+    std::vector<Piece> naivePlacements(const BasicBitBoard<W, H, V>& board, PieceType type, int spawnY) {
+        std::vector<Piece> result;
+        Piece spawn(type);
+        spawn.y = spawnY;
+        if (!spawn.canMove(board, 0, 0)) return result;
+
+        // 原点は盤面の外に最大 3 マスはみ出す
+        const int margin = 3, spanX = W + 2 * margin, spanY = H + 2 * margin;
+        std::vector<char> visited(4 * spanX * spanY, 0);
+        auto mark = [&](const Piece& p) {
+            char& v = visited[(static_cast<int>(p.rotation) * spanY + p.y + margin) * spanX + p.x + margin];
+            if (v) return false;
+            v = 1;
+            return true;
+        };
+
+        std::set<std::array<int, 4>> landed;
+        std::vector<Piece> queue{ spawn };
+        mark(spawn);
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            Piece p = queue[head];
+            auto push = [&](const Piece& next) { if (mark(next)) queue.push_back(next); };
+            for (int dx : { -1, 1 }) {
+                if (!p.canMove(board, dx, 0)) continue;
+                Piece next = p;
+                next.move(dx, 0);
+                push(next);
+            }
+            for (bool clockwise : { true, false }) {
+                Piece next = p;
+                if (next.rotate(board, clockwise)) push(next);
+            }
+            if (p.canMove(board, 0, 1)) {
+                Piece next = p;
+                next.move(0, 1);
+                push(next);
+                continue;
+            }
+            std::array<int, 4> cells;
+            auto positions = p.getAbsolutePositions();
+            for (int i = 0; i < 4; ++i) cells[i] = positions[i].y * W + positions[i].x;
+            std::sort(cells.begin(), cells.end());
+            if (landed.insert(cells).second) result.push_back(p);
+        }
+        return result;
+    }
+
+    // ピースを固定してライン消去する（色つきの盤面なら GameCore と同じく Piece::place で色も塗る）
+    template <int W, int H, int V>
+    void lockPiece(BasicBitBoard<W, H, V>& board, const Piece& p) {
+        board.placeMask(SRS_MASKS[static_cast<int>(p.type)][static_cast<int>(p.rotation)], p.x, p.y);
+        board.clearLines();
+    }
+
+    template <int W, int H, int V>
+    void lockPiece(BasicBoard<W, H, V>& board, const Piece& p) {
+        p.place(board);
+        board.clearLines();
+    }
+
+    template <typename BoardType>
+    std::uint64_t naivePerft(const BoardType& board, const std::vector<PieceType>& sequence,
+        int ply, int depth, int spawnY) {
+        std::vector<Piece> placements = naivePlacements(board, sequence[ply], spawnY);
+        if (depth == 1) return placements.size();
+
+        std::uint64_t nodes = 0;
+        for (const Piece& p : placements) {
+            BoardType next = board;
+            lockPiece(next, p);
+            nodes += naivePerft(next, sequence, ply + 1, depth - 1, spawnY);
+        }
+        return nodes;
+    }
+
+    // 基準局面を 10 × 40 の色つきの盤面（BufferedBoard）で数えて bufferedExpected と比べる
+    // 素朴な探索そのものは、同じ深さの 10 × 20 で MoveGenerator と一致することで確かめる
+    int verifyBuffered() {
+        int failures = 0;
+        for (const auto& pos : referencePositions()) {
+            std::vector<PieceType> sequence;
+            parseSequence(pos.sequence, sequence);
+            int depth = std::min(pos.depth, BUFFERED_DEPTH);
+
+            BitBoard small;
+            fillRows(small, pos.rows);
+            bool naiveOk = naivePerft(small, sequence, 0, depth, 0) == runPerft(makeBoard(pos.rows), sequence, depth);
+
+            BufferedBoard board;
+            fillRows(board, pos.rows);
+            std::uint64_t nodes = naivePerft(board, sequence, 0, depth, BufferedBoard::HIDDEN_ROWS);
+            bool ok = naiveOk && nodes == pos.bufferedExpected;
+            if (!ok) ++failures;
+            std::cout << (ok ? "ok   " : "FAIL ") << pos.name << " (10x40) seq=" << pos.sequence
+                << " depth=" << depth << " nodes=" << nodes << " expected=" << pos.bufferedExpected
+                << (naiveOk ? "" : " (naive search disagrees with MoveGenerator on 10x20)") << std::endl;
+        }
+        return failures;
+    }
+
+    int verify() {
+        int failures = 0;
+        for (const auto& pos : referencePositions()) {
+            std::vector<PieceType> sequence;
+            parseSequence(pos.sequence, sequence);
+            std::uint64_t nodes = runPerft(makeBoard(pos.rows), sequence, pos.depth);
+            bool ok = nodes == pos.expected;
+            if (!ok) ++failures;
+            std::cout << (ok ? "ok   " : "FAIL ") << pos.name << " seq=" << pos.sequence
+                << " depth=" << pos.depth << " nodes=" << nodes
+                << " expected=" << pos.expected << std::endl;
+        }
+        failures += verifyBuffered();
+        std::cout << (failures == 0 ? "all positions match" : "mismatch found") << std::endl;
+        return failures == 0 ? 0 : 1;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    std::string sequenceText = "TSZIOLJ", boardText;
+    int depth = 3;
+    bool fromBag = false, seeded = false;
+    std::uint64_t seed = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--verify") return verify();
+        else if (arg == "--seq" && i + 1 < argc) sequenceText = argv[++i];
+        else if (arg == "--depth" && i + 1 < argc) depth = std::atoi(argv[++i]);
+        else if (arg == "--board" && i + 1 < argc) boardText = argv[++i];
+        else if (arg == "--bag") fromBag = true;
+        else if (arg == "--seed" && i + 1 < argc) { seed = std::strtoull(argv[++i], nullptr, 10); seeded = true; }
+        else {
+            std::cerr << "usage: perft [--verify] [--seq TSZIOLJ | --bag [--seed S]] [--depth N] [--board ROWS]" << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<PieceType> sequence;
+    if (fromBag) {
+        Bag bag = seeded ? Bag(seed) : Bag();
+        sequenceText.clear();
+        for (int i = 0; i < depth; ++i) {
+            sequence.push_back(bag.getNext());
+            sequenceText += pieceTypeToString(sequence.back());
+        }
+    }
+    else if (!parseSequence(sequenceText, sequence)) {
+        std::cerr << "unknown piece in sequence: " << sequenceText << std::endl;
+        return 2;
+    }
+    if (depth < 1 || depth > static_cast<int>(sequence.size())) {
+        std::cerr << "depth must be between 1 and the sequence length" << std::endl;
+        return 2;
+    }
+
+    std::vector<std::string> boardRows;
+    if (!boardText.empty()) boardRows = splitRows(boardText);
+    if (static_cast<int>(boardRows.size()) > Board::HEIGHT) {
+        std::cerr << "--board has " << boardRows.size() << " rows, but the board is only " << Board::HEIGHT << " rows high" << std::endl;
+        return 2;
+    }
+    Board board = boardText.empty() ? Board(false) : makeBoard(boardRows);
+
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t nodes = runPerft(board, sequence, depth);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "seq=" << sequenceText << " depth=" << depth << " nodes=" << nodes
+        << " time=" << seconds << "s nps=" << static_cast<std::uint64_t>(nodes / (seconds > 0 ? seconds : 1e-9))
+        << std::endl;
+    return 0;
+}
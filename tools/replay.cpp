@@ -0,0 +1,61 @@
+// replay: 記録したリプレイ（.trpl）を確かめたり、途中の局面を表示したりするツール
+//
+// 使い方:
+//   replay game_0.trpl --verify        最初から再生し、すべての手とキーフレームが正しいか確かめる
+//   replay game_0.trpl --seek 120      120 手目を置く直前の盤面を表示する（直前のキーフレームから再生）
+//   replay game_0.trpl --bench         全体を再生する速度（pieces/s）を測る
+
+#include "../Replay.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: replay FILE (--verify | --seek N | --bench)" << std::endl;
+        return 2;
+    }
+
+    Replay replay;
+    if (!replay.load(argv[1])) {
+        std::cerr << "cannot read replay: " << argv[1] << std::endl;
+        return 1;
+    }
+    std::cout << "seed=" << replay.seed << " pieces=" << replay.pieceCount()
+        << " keyframes=" << replay.keyframes.size() << std::endl;
+
+    std::string mode = argv[2];
+    if (mode == "--verify") {
+        int failed = verifyReplay(replay);
+        if (failed >= 0) {
+            std::cout << "mismatch at piece " << failed << std::endl;
+            return 1;
+        }
+        std::cout << "ok" << std::endl;
+    }
+    else if (mode == "--seek" && argc > 3) {
+        ReplayPlayer player(replay);
+        int piece = std::atoi(argv[3]);
+        if (!player.seek(piece)) {
+            std::cout << "cannot reach piece " << piece << std::endl;
+            return 1;
+        }
+        std::cout << "current=" << pieceTypeToString(player.getCore().getCurrentPiece().type) << std::endl;
+        std::cout << player.getCore().getBoard().toString();
+    }
+    else if (mode == "--bench") {
+        auto start = std::chrono::steady_clock::now();
+        ReplayPlayer player(replay);
+        while (!player.finished())
+            if (!player.next()) break;
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "replayed=" << player.position() << " time=" << seconds << "s pieces/s="
+            << (seconds > 0 ? player.position() / seconds : 0.0) << std::endl;
+    }
+    else {
+        std::cerr << "unknown mode: " << mode << std::endl;
+        return 2;
+    }
+    return 0;
+}
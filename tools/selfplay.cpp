@@ -0,0 +1,167 @@
+// selfplay: ボット同士ではなく、ボットにヘッドレスのゲームを何局も並列で遊ばせるツール
+// 学習データの生成や評価関数の A/B 比較に使う。同じ引数なら何度実行しても同じ結果になる
+//
+// 使い方:
+//   selfplay --games 64 --threads 8 --seed 1 --pieces 500 --beam 64 --depth 4
+//   selfplay --depth 6 --chance 2              Next の先の見えないピースを2個まで期待値で読む（depth が Next を読み切るときだけ）
+//   selfplay --games 8 --record out        各局のリプレイを out/game_<番号>.trpl に保存する
+//   selfplay --games 64 --dataset data.tdat  各局の局面・選んだ手・結果を data.tdat の後ろに追記する（局番号の順）
+//   selfplay --metrics m.txt               終わったあとに、置いたピース・消したライン・回転のキックなどの回数を m.txt に書く
+//   selfplay --verify --threads 4 --chance 2
+//                                          同じ設定を1スレッドと4スレッドで遊び、すべての局の手が一致するか確かめる
+//                                          4スレッドの局はデータセットに書いてから読み戻し、1スレッドの局のレコードと比べる
+//                                          （--dataset がなければ selfplay_verify.tdat に書いて、終わったら消す）
+//
+// 1局ごとに「番号 シード ピース数 ライン数 終了理由 秒数」を1行ずつ出力し、最後に合計を出す
+
+#include "../Metrics.hpp"
+#include "../SelfPlay.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+    // path のデータセットを mmap で読み戻し、1スレッドで遊んだ局のレコードと件数・中身が一致するか確かめる
+    // 追記で開き直したときに、ファイルの大きさから同じ件数を数えられることも確かめる
+    bool verifyDataset(const SelfPlayReport& single, const std::string& path) {
+        std::vector<DatasetRecord> expected;
+        for (const auto& g : single.games) expected.insert(expected.end(), g.samples.begin(), g.samples.end());
+
+        DatasetReader reader;
+        bool opened = reader.open(path);
+        std::size_t read = opened ? reader.size() : 0, mismatched = 0;
+        for (std::size_t i = 0; i < std::min(read, expected.size()); ++i)
+            if (std::memcmp(&reader[i], &expected[i], sizeof(DatasetRecord)) != 0) ++mismatched;
+        reader.close();
+
+        DatasetWriter appender;
+        bool reopened = appender.open(path, true);
+        std::uint64_t counted = reopened ? appender.recordCount() : 0;
+        appender.close();
+
+        bool ok = opened && read == expected.size() && mismatched == 0 && reopened && counted == expected.size();
+        std::cout << (ok ? "ok   " : "FAIL ") << "dataset " << path << " records=" << read << "/" << expected.size()
+            << " mismatched=" << mismatched << " counted on reopen=" << counted << std::endl;
+        return ok;
+    }
+
+    // 1スレッドと threads スレッドで同じ局を遊び、各局の手の列と結果が一致するか確かめる
+    // ワーカーごとのボットがどの局を受け持つかはスレッド数で変わるので、
+    // 手や局をまたいで使い回す表が結果に影響していればここでずれる
+    // threads スレッドのほうは通常の実行と同じく sink からデータセットへ書き、読み戻して比べる
+    int verify(SelfPlayConfig config, const std::string& datasetPath) {
+        int threads = config.threads > 0 ? config.threads : static_cast<int>(std::thread::hardware_concurrency());
+        config.recordReplays = true;
+        config.recordSamples = true;
+        config.threads = 1;
+        SelfPlayReport single = runSelfPlay(config);
+
+        DatasetWriter dataset;
+        if (!dataset.open(datasetPath, false)) {
+            std::cerr << "cannot open dataset " << datasetPath << std::endl;
+            return 1;
+        }
+        // sink のあとで手の列とレコードは捨てられるので、手の列は sink の中で比べておく
+        std::vector<char> sameMoves(single.games.size(), 0);
+        config.threads = std::max(threads, 2);
+        SelfPlayReport parallel = runSelfPlay(config, [&](int i, const GameOutcome& g) {
+            sameMoves[i] = g.replay.events == single.games[i].replay.events ? 1 : 0;
+            dataset.append(g.samples.data(), g.samples.size());
+        });
+        if (!dataset.close()) std::cerr << "failed to write dataset " << datasetPath << std::endl;
+
+        int failures = 0;
+        for (std::size_t i = 0; i < single.games.size(); ++i) {
+            const GameOutcome& a = single.games[i];
+            const GameOutcome& b = parallel.games[i];
+            bool ok = a.pieces == b.pieces && a.lines == b.lines && a.toppedOut == b.toppedOut && sameMoves[i];
+            if (!ok) ++failures;
+            std::cout << (ok ? "ok   " : "FAIL ") << "game " << i << " seed=" << a.seed
+                << " lines=" << a.lines << "/" << b.lines << " pieces=" << a.pieces << "/" << b.pieces << std::endl;
+        }
+        bool datasetOk = verifyDataset(single, datasetPath);
+        std::cout << (failures == 0 ? "1 thread and " : "mismatch between 1 thread and ") << config.threads
+            << " threads" << (failures == 0 ? " match" : "") << std::endl;
+        return failures == 0 && datasetOk ? 0 : 1;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    SelfPlayConfig config;
+    config.bot.beamWidth = 64;
+    config.bot.maxDepth = 4;
+    std::string recordDir;
+    std::string datasetPath;
+    std::string metricsPath;
+    bool verifyRuns = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--games" && hasValue) config.games = std::atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue) config.threads = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) config.baseSeed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--pieces" && hasValue) config.maxPieces = std::atoi(argv[++i]);
+        else if (arg == "--beam" && hasValue) config.bot.beamWidth = std::atoi(argv[++i]);
+        else if (arg == "--depth" && hasValue) config.bot.maxDepth = std::atoi(argv[++i]);
+        else if (arg == "--chance" && hasValue) config.bot.chanceDepth = std::atoi(argv[++i]);
+        else if (arg == "--no-hold") config.bot.useHold = false;
+        else if (arg == "--record" && hasValue) recordDir = argv[++i];
+        else if (arg == "--dataset" && hasValue) datasetPath = argv[++i];
+        else if (arg == "--metrics" && hasValue) metricsPath = argv[++i];
+        else if (arg == "--verify") verifyRuns = true;
+        else {
+            std::cerr << "usage: selfplay [--games N] [--threads N] [--seed S] [--pieces N] [--beam W] [--depth D] [--chance D] [--no-hold] [--record DIR] [--dataset FILE] [--metrics FILE] [--verify]" << std::endl;
+            return 2;
+        }
+    }
+
+    if (verifyRuns) {
+        std::string path = datasetPath.empty() ? "selfplay_verify.tdat" : datasetPath;
+        int result = verify(config, path);
+        if (datasetPath.empty()) std::remove(path.c_str());
+        return result;
+    }
+
+    config.recordReplays = !recordDir.empty();
+    config.recordSamples = !datasetPath.empty();
+    DatasetWriter dataset;
+    if (config.recordSamples && !dataset.open(datasetPath)) {
+        std::cerr << "cannot open dataset " << datasetPath << std::endl;
+        return 1;
+    }
+    // 終わった局から順に書き出す（全局の記録をメモリにためない）
+    GameSink sink;
+    if (config.recordReplays || config.recordSamples) {
+        sink = [&](int i, const GameOutcome& g) {
+            if (config.recordReplays && !g.replay.save(recordDir + "/game_" + std::to_string(i) + ".trpl"))
+                std::cerr << "failed to write replay for game " << i << std::endl;
+            if (config.recordSamples) dataset.append(g.samples.data(), g.samples.size());
+        };
+    }
+    SelfPlayReport report = runSelfPlay(config, sink);
+
+    for (std::size_t i = 0; i < report.games.size(); ++i) {
+        const GameOutcome& g = report.games[i];
+        std::cout << "game " << i << " seed=" << g.seed << " pieces=" << g.pieces << " lines=" << g.lines
+            << " end=" << (g.toppedOut ? "topout" : "limit") << " time=" << g.seconds << "s" << std::endl;
+    }
+    if (config.recordSamples && !dataset.close()) {
+        std::cerr << "failed to write dataset " << datasetPath << std::endl;
+        return 1;
+    }
+    std::cout << "games=" << report.games.size() << " pieces=" << report.totalPieces << " lines=" << report.totalLines
+        << " time=" << report.seconds << "s pieces/s=" << report.piecesPerSecond()
+        << " games/s=" << report.gamesPerSecond() << std::endl;
+    if (!metricsPath.empty() && !Metrics::instance().dump(metricsPath)) {
+        std::cerr << "failed to write metrics " << metricsPath << std::endl;
+        return 1;
+    }
+    return 0;
+}